@@ -0,0 +1,133 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Micro-benchmarks for everything of this module that runs per world tick or
+// per fire. Paths that need a live World/config environment (the full Init()
+// parse, broadcasts, the DB slot claim) are deliberately not covered - they
+// run once per day, not per tick, and cannot be driven outside a worldserver.
+
+#include "ServerAutoShutdown.h"
+#include "ServerAutoShutdownTimeSpec.h"
+#include "StringFormat.h"
+
+#include <benchmark/benchmark.h>
+
+#include <ctime>
+
+namespace
+{
+    // The wheel callbacks only dereference the owner when a slot fires; every
+    // benchmark below arms deadlines far beyond the simulated diff, so this
+    // reference is never touched
+    alignas(ServerAutoShutdown*) unsigned char ownerStorage[sizeof(void*)];
+    ServerAutoShutdown& DummyOwner() { return *reinterpret_cast<ServerAutoShutdown*>(ownerStorage); }
+
+    void NeverFires(ServerAutoShutdown& /*self*/) { }
+
+    // Local copy of GetNextResetTime (anonymous namespace in the module TU),
+    // kept only to measure what the mktime-based path costs per call
+    time_t NextResetTimeViaMktime(time_t time, uint32 day, uint8 hour, uint8 minute, uint8 second)
+    {
+        tm timeLocal;
+        localtime_r(&time, &timeLocal);
+        timeLocal.tm_hour = hour;
+        timeLocal.tm_min = minute;
+        timeLocal.tm_sec = second;
+
+        time_t midnightLocal = mktime(&timeLocal);
+
+        if (day > 1 || midnightLocal <= time)
+            midnightLocal += 86400 * day;
+
+        return midnightLocal;
+    }
+}
+
+static void BM_ParseTimeSpec(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(ParseTimeSpec("04:30:15"));
+}
+BENCHMARK(BM_ParseTimeSpec);
+
+static void BM_NextResetTimeViaMktime(benchmark::State& state)
+{
+    time_t now = time(nullptr);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(NextResetTimeViaMktime(now, 1, 4, 0, 0));
+}
+BENCHMARK(BM_NextResetTimeViaMktime);
+
+// One wheel tick with 0..MAX_SHUTDOWN_TIMERS armed slots, none firing -
+// the cost OnUpdate pays whenever the gate is open
+static void BM_TimerWheelTick(benchmark::State& state)
+{
+    ShutdownTimerWheel wheel;
+    for (int64_t slot = 0; slot < state.range(0); ++slot)
+        wheel.Arm(static_cast<ShutdownTimerKind>(slot), uint64(DAY) * IN_MILLISECONDS, 0, &NeverFires);
+
+    for (auto _ : state)
+    {
+        wheel.Update(DummyOwner(), 50);
+        benchmark::DoNotOptimize(wheel);
+    }
+}
+BENCHMARK(BM_TimerWheelTick)->DenseRange(0, MAX_SHUTDOWN_TIMERS);
+
+static void BM_TimerWheelMsToNextFire(benchmark::State& state)
+{
+    ShutdownTimerWheel wheel;
+    for (uint8 slot = 0; slot < MAX_SHUTDOWN_TIMERS; ++slot)
+        wheel.Arm(static_cast<ShutdownTimerKind>(slot), (slot + 1) * 1000ull, 0, &NeverFires);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(wheel.MsToNextFire(uint64(DAY) * IN_MILLISECONDS));
+}
+BENCHMARK(BM_TimerWheelMsToNextFire);
+
+// The OnUpdate fast path while the gate is closed: one add and one compare
+static void BM_UpdateGateClosed(benchmark::State& state)
+{
+    uint32 msSinceLastUpdate = 0;
+    uint32 msToNextTask = 3600 * IN_MILLISECONDS;
+    uint32 opened = 0;
+
+    for (auto _ : state)
+    {
+        msSinceLastUpdate += 50;
+        if (msSinceLastUpdate + 5 * IN_MILLISECONDS >= msToNextTask)
+        {
+            ++opened;
+            msSinceLastUpdate = 0;
+        }
+
+        benchmark::DoNotOptimize(opened);
+    }
+}
+BENCHMARK(BM_UpdateGateClosed);
+
+// What one announce used to cost per fire before the per-locale tables
+// moved all formatting to Init()
+static void BM_AnnounceFormat(benchmark::State& state)
+{
+    std::string format = "[SERVER]: Automated (quick) server restart in {}";
+    std::string timeString = "59 Minute(s) 30 Second(s)";
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(Acore::StringFormat(format, timeString));
+}
+BENCHMARK(BM_AnnounceFormat);
@@ -0,0 +1,10 @@
+--
+-- Restart slot claims for staggered multi-realm shutdowns. One row per
+-- (maintenance window, slot); the realm that wins the primary key owns it.
+--
+CREATE TABLE IF NOT EXISTS `server_auto_shutdown_slots` (
+  `shutdown_time` BIGINT UNSIGNED NOT NULL,
+  `slot` INT UNSIGNED NOT NULL,
+  `realm_id` INT UNSIGNED NOT NULL,
+  PRIMARY KEY (`shutdown_time`, `slot`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci;
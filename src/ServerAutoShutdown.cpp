@@ -16,23 +16,63 @@
  */
 
 #include "ServerAutoShutdown.h"
+#include "ServerAutoShutdownTimeSpec.h"
+#include "Chat.h"
 #include "Config.h"
+#include "DatabaseEnv.h"
 #include "Duration.h"
 #include "GameEventMgr.h"
+#include "GameTime.h"
 #include "Language.h"
 #include "Log.h"
+#include "Map.h"
+#include "MapMgr.h"
+#include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "Player.h"
+#include "Realm.h"
+#include "Optional.h"
 #include "StringConvert.h"
 #include "StringFormat.h"
-#include "TaskScheduler.h"
 #include "Tokenize.h"
 #include "Util.h"
 #include "World.h"
+#include "WorldSession.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdio>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
 namespace
 {
-    // Scheduler - for update
-    TaskScheduler scheduler;
+    // Enter the timer wheel update only when the next deadline is this close.
+    // Outside the window OnUpdate is a single integer comparison per tick
+    constexpr uint32 SCHEDULER_WAKEUP_WINDOW_MS = 5 * IN_MILLISECONDS;
+
+    // Gate value when the wheel is idle
+    constexpr uint64 IDLE_GATE_MS = uint64(DAY) * IN_MILLISECONDS;
+
+    // Spacing between two deferred game event starts after startup
+    constexpr uint64 EVENT_START_SPACING_MS = 500;
+
+    // How often the absolute slots are re-anchored against the wall clock.
+    // Bounds how far an NTP step or DST transition can shift a fire time
+    constexpr uint64 CLOCK_RESYNC_INTERVAL_MS = uint64(MINUTE) * IN_MILLISECONDS;
 
     time_t GetNextResetTime(time_t time, uint32 day, uint8 hour, uint8 minute, uint8 second)
     {
@@ -48,6 +88,327 @@ namespace
 
         return midnightLocal;
     }
+
+    // Parse a weekday spec like "*", "Mon,Tue,Fri" or "0,6" into a tm_wday bitmask
+    Optional<uint8> ParseDayMask(std::string_view spec)
+    {
+        if (spec == "*")
+            return uint8(0x7F);
+
+        constexpr std::array<std::string_view, 7> dayNames = { "sun", "mon", "tue", "wed", "thu", "fri", "sat" };
+
+        uint8 mask = 0;
+        for (auto token : Acore::Tokenize(spec, ',', false))
+        {
+            if (auto dayNumber = Acore::StringTo<uint8>(token); dayNumber && *dayNumber <= 6)
+            {
+                mask |= 1 << *dayNumber;
+                continue;
+            }
+
+            std::string lowered(token.substr(0, 3));
+            strToLower(lowered);
+
+            auto itr = std::find(dayNames.begin(), dayNames.end(), lowered);
+            if (itr == dayNames.end())
+                return std::nullopt;
+
+            mask |= 1 << std::distance(dayNames.begin(), itr);
+        }
+
+        return mask ? Optional<uint8>(mask) : std::nullopt;
+    }
+
+    // Expand all schedule entries into sorted epoch seconds over the horizon,
+    // so "next shutdown" lookups at runtime are plain array reads
+    std::vector<time_t> ExpandFireTimes(std::vector<ShutdownScheduleEntry> const& entries, time_t from, uint32 horizonDays)
+    {
+        tm timeLocal = Acore::Time::TimeBreakdown(from);
+        timeLocal.tm_hour = 0;
+        timeLocal.tm_min = 0;
+        timeLocal.tm_sec = 0;
+
+        time_t midnight = mktime(&timeLocal);
+        int baseWeekDay = timeLocal.tm_wday;
+
+        std::vector<time_t> fireTimes;
+        for (uint32 dayOffset = 0; dayOffset <= horizonDays; ++dayOffset)
+        {
+            int weekDay = (baseWeekDay + dayOffset) % 7;
+            time_t dayStart = midnight + time_t(86400) * dayOffset;
+
+            for (auto const& entry : entries)
+            {
+                if (!(entry.DayMask & (1 << weekDay)))
+                    continue;
+
+                time_t fireTime = dayStart + entry.Hour * HOUR + entry.Minute * MINUTE + entry.Second;
+
+                // Same guard as the legacy path: never arm closer than 10 seconds out
+                if (fireTime > from + 10)
+                    fireTimes.emplace_back(fireTime);
+            }
+        }
+
+        std::sort(fireTimes.begin(), fireTimes.end());
+        fireTimes.erase(std::unique(fireTimes.begin(), fireTimes.end()), fireTimes.end());
+        return fireTimes;
+    }
+
+    // Format one announce for every locale that has a template; empty entries
+    // fall back to the default locale at broadcast time
+    ServerAutoShutdownConfig::AnnounceMessages BuildAnnounceMessages(ServerAutoShutdownConfig const& config, uint32 seconds)
+    {
+        ServerAutoShutdownConfig::AnnounceMessages messages;
+        std::string timeString = Acore::Time::ToTimeString<Seconds>(seconds, TimeOutput::Seconds, TimeFormat::FullText);
+
+        messages[DEFAULT_LOCALE] = Acore::StringFormat(config.PreAnnounceMessage, timeString);
+
+        for (uint8 locale = 0; locale < TOTAL_LOCALES; ++locale)
+            if (locale != DEFAULT_LOCALE && !config.LocaleMessageFormats[locale].empty())
+                messages[locale] = Acore::StringFormat(config.LocaleMessageFormats[locale], timeString);
+
+        return messages;
+    }
+
+    // Resident set size in MB, one short read of /proc/self/statm per sample.
+    // Returns 0 on platforms without procfs, which disables the RSS trigger
+    uint32 GetResidentSetMB()
+    {
+#ifdef __linux__
+        FILE* file = fopen("/proc/self/statm", "r");
+        if (!file)
+            return 0;
+
+        unsigned long pagesTotal = 0;
+        unsigned long pagesResident = 0;
+        int matched = fscanf(file, "%lu %lu", &pagesTotal, &pagesResident);
+        fclose(file);
+
+        if (matched != 2)
+            return 0;
+
+        return static_cast<uint32>(uint64(pagesResident) * uint64(sysconf(_SC_PAGESIZE)) / (1024 * 1024));
+#else
+        return 0;
+#endif
+    }
+
+    // Claim the first free restart slot for this maintenance window in the
+    // shared auth DB table. INSERT IGNORE plus read-back is race-safe across
+    // realms: whoever wins the primary key owns the slot, everyone else moves
+    // on to the next one. Returns 0 (no offset) when the table is full
+    uint32 ClaimRestartSlot(time_t baseTime, uint32 maxSlots)
+    {
+        // Prune exhausted windows so the table stays a handful of rows
+        LoginDatabase.DirectExecute("DELETE FROM `server_auto_shutdown_slots` WHERE `shutdown_time` < {}", static_cast<uint64>(time(nullptr)));
+
+        for (uint32 slot = 0; slot < maxSlots; ++slot)
+        {
+            LoginDatabase.DirectExecute("INSERT IGNORE INTO `server_auto_shutdown_slots` (`shutdown_time`, `slot`, `realm_id`) VALUES ({}, {}, {})",
+                static_cast<uint64>(baseTime), slot, realm.Id.Realm);
+
+            // Re-claiming the own slot after a config reload lands here too
+            QueryResult result = LoginDatabase.Query("SELECT `realm_id` FROM `server_auto_shutdown_slots` WHERE `shutdown_time` = {} AND `slot` = {}",
+                static_cast<uint64>(baseTime), slot);
+
+            if (result && (*result)[0].Get<uint32>() == realm.Id.Realm)
+                return slot;
+        }
+
+        LOG_WARN("module", "> ServerAutoShutdown: All {} restart slots claimed by other realms, using the base shutdown time", maxSlots);
+        return 0;
+    }
+
+    // Warm-restart state file: versioned little binary dump of the computed
+    // snapshot and fire table, invalidated through the config hash
+    constexpr uint32 STATE_FILE_MAGIC = 0x53415357; // 'SASW'
+    constexpr uint32 STATE_FILE_VERSION = 13;
+
+    std::string GetStateFilePath()
+    {
+        return sConfigMgr->GetOption<std::string>("ServerAutoShutdown.StateFile", "server_auto_shutdown.state");
+    }
+
+    template<typename T>
+    void AppendPod(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<char const*>(&value), sizeof(value));
+    }
+
+    void AppendString(std::string& out, std::string const& value)
+    {
+        AppendPod<uint32>(out, static_cast<uint32>(value.size()));
+        out.append(value);
+    }
+
+    // Sequential reader over the whole file buffer, every read bounds-checked
+    struct StateReader
+    {
+        std::string Buffer;
+        std::size_t Pos = 0;
+        bool Ok = true;
+
+        template<typename T>
+        T Read()
+        {
+            T value{};
+            if (Pos + sizeof(T) > Buffer.size())
+            {
+                Ok = false;
+                return value;
+            }
+
+            std::memcpy(&value, Buffer.data() + Pos, sizeof(T));
+            Pos += sizeof(T);
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            uint32 length = Read<uint32>();
+            if (!Ok || Pos + length > Buffer.size())
+            {
+                Ok = false;
+                return {};
+            }
+
+            std::string value(Buffer.data() + Pos, length);
+            Pos += length;
+            return value;
+        }
+    };
+
+    // Restart telemetry: fixed-size binary ring buffer of one record per
+    // initiated restart. All writes are in-place single-record updates on a
+    // stack buffer - no allocation on the shutdown path
+    constexpr uint32 TELEMETRY_MAGIC = 0x53415354; // 'SAST'
+    constexpr uint32 TELEMETRY_VERSION = 1;
+    constexpr std::size_t TELEMETRY_HEADER_SIZE = 16; // magic, version, capacity, head
+    constexpr std::size_t TELEMETRY_RECORD_SIZE = 41;
+
+    bool IsTelemetryEnabled()
+    {
+        return sConfigMgr->GetOption<bool>("ServerAutoShutdown.Telemetry.Enabled", false);
+    }
+
+    std::string GetTelemetryFilePath()
+    {
+        return sConfigMgr->GetOption<std::string>("ServerAutoShutdown.Telemetry.File", "server_auto_shutdown_telemetry.bin");
+    }
+
+    uint32 GetTelemetryCapacity()
+    {
+        uint32 capacity = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Telemetry.Records", 64);
+        return std::clamp<uint32>(capacity, 1, 4096);
+    }
+
+    void EncodeTelemetryRecord(char* out, ServerAutoShutdownRestartRecord const& record)
+    {
+        std::size_t pos = 0;
+        auto put = [&](auto value) { std::memcpy(out + pos, &value, sizeof(value)); pos += sizeof(value); };
+
+        put(record.ScheduledFireTime);
+        put(record.RequestedFireTime);
+        put(record.ExitTime);
+        put(record.CountdownSeconds);
+        put(record.SessionsAtPreAnnounce);
+        put(record.SessionsAtFire);
+        put(record.ShutdownDurationSeconds);
+        put(uint8(record.Complete ? 1 : 0));
+    }
+
+    ServerAutoShutdownRestartRecord DecodeTelemetryRecord(char const* in)
+    {
+        ServerAutoShutdownRestartRecord record;
+        std::size_t pos = 0;
+        auto get = [&](auto& value) { std::memcpy(&value, in + pos, sizeof(value)); pos += sizeof(value); };
+
+        get(record.ScheduledFireTime);
+        get(record.RequestedFireTime);
+        get(record.ExitTime);
+        get(record.CountdownSeconds);
+        get(record.SessionsAtPreAnnounce);
+        get(record.SessionsAtFire);
+        get(record.ShutdownDurationSeconds);
+
+        uint8 complete = 0;
+        get(complete);
+        record.Complete = complete != 0;
+        return record;
+    }
+
+    // Open the ring buffer for in-place record updates, (re)creating it when
+    // missing, truncated or sized for a different capacity. False only when
+    // the file cannot be created at all
+    bool OpenTelemetryFile(std::fstream& file, uint32& capacity, uint32& head)
+    {
+        capacity = GetTelemetryCapacity();
+        head = 0;
+
+        file.open(GetTelemetryFilePath(), std::ios::binary | std::ios::in | std::ios::out);
+        if (file)
+        {
+            uint32 magic = 0;
+            uint32 version = 0;
+            uint32 fileCapacity = 0;
+
+            file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+            file.read(reinterpret_cast<char*>(&version), sizeof(version));
+            file.read(reinterpret_cast<char*>(&fileCapacity), sizeof(fileCapacity));
+            file.read(reinterpret_cast<char*>(&head), sizeof(head));
+
+            if (file && magic == TELEMETRY_MAGIC && version == TELEMETRY_VERSION && fileCapacity == capacity && head < capacity)
+                return true;
+
+            file.close();
+        }
+
+        // Fresh file: header plus capacity zeroed records
+        file.clear();
+        file.open(GetTelemetryFilePath(), std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            LOG_ERROR("module", "> ServerAutoShutdown: Can't write telemetry file '{}'", GetTelemetryFilePath());
+            return false;
+        }
+
+        head = 0;
+        file.write(reinterpret_cast<char const*>(&TELEMETRY_MAGIC), sizeof(TELEMETRY_MAGIC));
+        file.write(reinterpret_cast<char const*>(&TELEMETRY_VERSION), sizeof(TELEMETRY_VERSION));
+        file.write(reinterpret_cast<char const*>(&capacity), sizeof(capacity));
+        file.write(reinterpret_cast<char const*>(&head), sizeof(head));
+
+        char zeroed[TELEMETRY_RECORD_SIZE] = {};
+        for (uint32 slot = 0; slot < capacity; ++slot)
+            file.write(zeroed, sizeof(zeroed));
+
+        file.flush();
+        file.seekg(TELEMETRY_HEADER_SIZE);
+        return true;
+    }
+
+    void WriteTelemetryRecord(std::fstream& file, uint32 slot, ServerAutoShutdownRestartRecord const& record)
+    {
+        char buffer[TELEMETRY_RECORD_SIZE];
+        EncodeTelemetryRecord(buffer, record);
+
+        file.seekp(TELEMETRY_HEADER_SIZE + std::streamoff(slot) * TELEMETRY_RECORD_SIZE);
+        file.write(buffer, sizeof(buffer));
+    }
+
+    bool ReadTelemetryRecord(std::fstream& file, uint32 slot, ServerAutoShutdownRestartRecord& record)
+    {
+        char buffer[TELEMETRY_RECORD_SIZE];
+
+        file.seekg(TELEMETRY_HEADER_SIZE + std::streamoff(slot) * TELEMETRY_RECORD_SIZE);
+        file.read(buffer, sizeof(buffer));
+        if (!file)
+            return false;
+
+        record = DecodeTelemetryRecord(buffer);
+        return true;
+    }
 }
 
 /*static*/ ServerAutoShutdown* ServerAutoShutdown::instance()
@@ -56,155 +417,2379 @@ namespace
     return &instance;
 }
 
-void ServerAutoShutdown::Init()
+std::shared_ptr<ServerAutoShutdownConfig const> ServerAutoShutdown::LoadConfig() const
 {
-    _isEnableModule = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Enabled", false);
+    auto config = std::make_shared<ServerAutoShutdownConfig>();
 
-    if (!_isEnableModule)
-        return;
+    config->Enabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Enabled", false);
+
+    // Parsed before the disabled-module early return on purpose: a snapshot
+    // that disables the module must still say whether the config watcher
+    // stays up, or an edit could never re-enable anything
+    config->HotWatchEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.HotWatch.Enabled", false);
+    config->HotWatchFile = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.HotWatch.File", "");
+
+    if (config->HotWatchEnabled && config->HotWatchFile.empty())
+    {
+        // Default to the module config next to the core config file
+        std::string coreConfig = sConfigMgr->GetFilename();
+        std::size_t slash = coreConfig.find_last_of("/\\");
+        config->HotWatchFile = (slash == std::string::npos ? std::string() : coreConfig.substr(0, slash + 1)) + "modules/ServerAutoShutdown.conf";
+    }
+
+#ifndef __linux__
+    if (config->HotWatchEnabled)
+    {
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.HotWatch.Enabled' needs inotify and is only supported on Linux, hot watch disabled");
+        config->HotWatchEnabled = false;
+    }
+#endif
+
+    if (!config->Enabled)
+        return config;
 
     std::string configTime = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.Time", "04:00:00");
-    auto const& tokens = Acore::Tokenize(configTime, ':', false);
 
-    if (tokens.size() != 3)
+    // Single pass, no tokenization, parses and range-checks every value once
+    auto timeSpec = ParseTimeSpec(configTime);
+    if (!timeSpec)
     {
         LOG_ERROR("module", "> ServerAutoShutdown: Incorrect time in config option 'ServerAutoShutdown.Time' - '{}'", configTime);
-        _isEnableModule = false;
-        return;
+        return nullptr;
     }
 
-    // Check convert to int
-    auto CheckTime = [tokens](std::initializer_list<uint8> index)
+    config->EveryDays = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.EveryDays", 1);
+    config->Hour = timeSpec->Hour;
+    config->Minute = timeSpec->Minute;
+    config->Second = timeSpec->Second;
+
+    if (config->EveryDays < 1 || config->EveryDays > 365)
+    {
+        LOG_ERROR("module", "> ServerAutoShutdown: Incorrect day in config option 'ServerAutoShutdown.EveryDays' - '{}'", config->EveryDays);
+        return nullptr;
+    }
+
+    config->PreAnnounceSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.PreAnnounce.Seconds", 3600);
+    if (config->PreAnnounceSeconds > 86400)
+    {
+        LOG_ERROR("module", "> ServerAutoShutdown: Ahah, how could this happen? Time to preannouce has been set to more than 1 day? ({}). Change to 1 hour (3600)", config->PreAnnounceSeconds);
+        config->PreAnnounceSeconds = 3600;
+    }
+
+    config->PreAnnounceMessage = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.PreAnnounce.Message", "[SERVER]: Automated (quick) server restart in {}");
+    config->StartEvents = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.StartEvents", "");
+
+    // Per-locale message templates, e.g. ...Message.Locale.3 for frFR
+    config->LocaleMessageFormats[DEFAULT_LOCALE] = config->PreAnnounceMessage;
+    for (uint8 locale = 0; locale < TOTAL_LOCALES; ++locale)
     {
-        for (auto const& itr : index)
+        if (locale == DEFAULT_LOCALE)
+            continue;
+
+        config->LocaleMessageFormats[locale] = sConfigMgr->GetOption<std::string>(Acore::StringFormat("ServerAutoShutdown.PreAnnounce.Message.Locale.{}", locale), "");
+        if (!config->LocaleMessageFormats[locale].empty())
+            config->HasLocalizedMessages = true;
+    }
+    config->UseTimerThread = sConfigMgr->GetOption<bool>("ServerAutoShutdown.UseTimerThread", false);
+
+    std::string schedules = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.Schedules", "");
+    if (!schedules.empty())
+    {
+        for (auto entryToken : Acore::Tokenize(schedules, ';', false))
+        {
+            if (entryToken.empty())
+                continue;
+
+            auto parts = Acore::Tokenize(entryToken, '@', false);
+            if (parts.size() != 2)
+            {
+                LOG_ERROR("module", "> ServerAutoShutdown: Incorrect entry in config option 'ServerAutoShutdown.Schedules' - '{}'", entryToken);
+                return nullptr;
+            }
+
+            auto dayMask = ParseDayMask(parts.at(0));
+            auto entryTime = ParseTimeSpec(parts.at(1));
+
+            if (!dayMask || !entryTime)
+            {
+                LOG_ERROR("module", "> ServerAutoShutdown: Incorrect entry in config option 'ServerAutoShutdown.Schedules' - '{}'", entryToken);
+                return nullptr;
+            }
+
+            config->Schedules.emplace_back(ShutdownScheduleEntry{ *dayMask, entryTime->Hour, entryTime->Minute, entryTime->Second });
+        }
+
+        if (config->Schedules.empty())
         {
-            if (!Acore::StringTo<uint8>(tokens.at(itr)))
-                return false;
+            LOG_ERROR("module", "> ServerAutoShutdown: No valid entries in config option 'ServerAutoShutdown.Schedules' - '{}'", schedules);
+            return nullptr;
         }
+    }
 
-        return true;
-    };
+    config->PreFlushEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.PreFlush.Enabled", false);
+    config->PreFlushBatchSize = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.PreFlush.BatchSize", 10);
+    config->PreFlushIntervalMs = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.PreFlush.IntervalMs", 1000);
+
+    if (!config->PreFlushBatchSize)
+        config->PreFlushBatchSize = 10;
 
-    if (!CheckTime({ 0, 1, 2 }))
+    if (config->PreFlushIntervalMs < 100)
+        config->PreFlushIntervalMs = 100;
+
+    if (config->PreFlushEnabled && config->UseTimerThread)
     {
-        LOG_ERROR("module", "> ServerAutoShutdown: Incorrect time in config option 'ServerAutoShutdown.Time' - '{}'", configTime);
-        _isEnableModule = false;
-        return;
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.PreFlush.Enabled' is not supported with 'ServerAutoShutdown.UseTimerThread', flush pipeline disabled");
+        config->PreFlushEnabled = false;
     }
 
-    uint32 day =  sConfigMgr->GetOption<uint32>("ServerAutoShutdown.EveryDays", 1);
-    uint8 hour = *Acore::StringTo<uint8>(tokens.at(0));
-    uint8 minute = *Acore::StringTo<uint8>(tokens.at(1));
-    uint8 second = *Acore::StringTo<uint8>(tokens.at(2));
+    config->PerfEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Perf.Enabled", false);
+
+    config->VetoBackoffSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Veto.BackoffSeconds", 60);
+    config->VetoMaxExtendSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Veto.MaxExtendSeconds", 1800);
+
+    if (!config->VetoBackoffSeconds)
+        config->VetoBackoffSeconds = 60;
+
+    config->StaggerEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Stagger.Enabled", false);
+    config->StaggerStepSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Stagger.StepSeconds", 300);
+    config->StaggerMaxSlots = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Stagger.MaxSlots", 16);
+
+    if (!config->StaggerStepSeconds)
+        config->StaggerStepSeconds = 300;
 
-    if (day < 1 || day > 365)
+    if (!config->StaggerMaxSlots)
+        config->StaggerMaxSlots = 16;
+
+    config->DrainEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Drain.Enabled", false);
+    config->DrainBatchSize = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Drain.BatchSize", 5);
+    config->DrainIntervalMs = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Drain.IntervalMs", 5000);
+
+    if (!config->DrainBatchSize)
+        config->DrainBatchSize = 5;
+
+    if (config->DrainIntervalMs < 1000)
+        config->DrainIntervalMs = 1000;
+
+    if (config->DrainEnabled && config->UseTimerThread)
     {
-        LOG_ERROR("module", "> ServerAutoShutdown: Incorrect day in config option 'ServerAutoShutdown.EveryDays' - '{}'", day);
-        _isEnableModule = false;
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.Drain.Enabled' is not supported with 'ServerAutoShutdown.UseTimerThread', session drain disabled");
+        config->DrainEnabled = false;
     }
-    else if (hour > 23)
+
+    config->WindowEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Window.Enabled", false);
+    config->WindowMaxExtendSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Window.MaxExtendSeconds", 7200);
+    config->WindowMaxSessions = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Window.MaxSessions", 10);
+    config->WindowSampleSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Window.SampleSeconds", 30);
+    config->WindowFireDelaySeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Window.FireDelaySeconds", 60);
+
+    if (!config->WindowSampleSeconds)
+        config->WindowSampleSeconds = 30;
+
+    if (config->WindowEnabled && config->UseTimerThread)
     {
-        LOG_ERROR("module", "> ServerAutoShutdown: Incorrect hour in config option 'ServerAutoShutdown.Time' - '{}'", configTime);
-        _isEnableModule = false;
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.Window.Enabled' is not supported with 'ServerAutoShutdown.UseTimerThread', window disabled");
+        config->WindowEnabled = false;
     }
-    else if (minute >= 60)
+
+    config->WebhookEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Webhook.Enabled", false);
+    config->WebhookUrl = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.Webhook.Url", "");
+    config->WebhookTimeoutMs = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Webhook.TimeoutMs", 2000);
+
+    if (!config->WebhookTimeoutMs)
+        config->WebhookTimeoutMs = 2000;
+
+    if (config->WebhookEnabled)
     {
-        LOG_ERROR("module", "> ServerAutoShutdown: Incorrect minute in config option 'ServerAutoShutdown.Time' - '{}'", configTime);
-        _isEnableModule = false;
+        // Split http://host[:port]/path once here; the worker never parses
+        std::string_view url = config->WebhookUrl;
+        if (url.substr(0, 7) == "http://")
+        {
+            url.remove_prefix(7);
+
+            std::size_t slash = url.find('/');
+            std::string_view hostPort = url.substr(0, slash);
+            config->WebhookTarget = slash == std::string_view::npos ? "/" : std::string(url.substr(slash));
+
+            std::size_t colon = hostPort.find(':');
+            config->WebhookHost = std::string(hostPort.substr(0, colon));
+            config->WebhookPort = colon == std::string_view::npos ? "80" : std::string(hostPort.substr(colon + 1));
+        }
+
+        if (config->WebhookHost.empty())
+        {
+            LOG_ERROR("module", "> ServerAutoShutdown: Incorrect url in config option 'ServerAutoShutdown.Webhook.Url' - '{}' (only http:// is supported, terminate TLS in a local relay), webhook disabled", config->WebhookUrl);
+            config->WebhookEnabled = false;
+        }
     }
-    else if (second >= 60)
+
+    config->PreUnloadEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.PreUnload.Enabled", false);
+    config->PreUnloadBatchSize = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.PreUnload.BatchSize", 2);
+    config->PreUnloadIntervalMs = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.PreUnload.IntervalMs", 2000);
+
+    if (!config->PreUnloadBatchSize)
+        config->PreUnloadBatchSize = 2;
+
+    if (config->PreUnloadIntervalMs < 500)
+        config->PreUnloadIntervalMs = 500;
+
+    if (config->PreUnloadEnabled && config->UseTimerThread)
     {
-        LOG_ERROR("module", "> ServerAutoShutdown: Incorrect second in config option 'ServerAutoShutdown.Time' - '{}'", configTime);
-        _isEnableModule = false;
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.PreUnload.Enabled' is not supported with 'ServerAutoShutdown.UseTimerThread', map pre-unload disabled");
+        config->PreUnloadEnabled = false;
     }
 
-    auto nowTime = time(nullptr);
-    //Seconds nowTime = GameTime::GetGameTime();
-    uint64 nextResetTime = GetNextResetTime(nowTime, day, hour, minute, second);
-    uint32 diffToShutdown = nextResetTime - static_cast<uint32>(nowTime);
+    config->MaintenanceEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Maintenance.Enabled", false);
+    config->MaintenanceDeadlineSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Maintenance.DeadlineSeconds", 120);
 
-    if (diffToShutdown < 10)
+    std::string maintenanceTasks = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.Maintenance.Tasks", "");
+    for (auto token : Acore::Tokenize(maintenanceTasks, ';', false))
     {
-        LOG_WARN("module", "> ServerAutoShutdown: Next time to shutdown < 10 seconds, Set next day");
-        nextResetTime += 86400 * day;
-        diffToShutdown = nextResetTime - static_cast<uint32>(nowTime);
+        while (!token.empty() && token.front() == ' ')
+            token.remove_prefix(1);
+        while (!token.empty() && token.back() == ' ')
+            token.remove_suffix(1);
+
+        if (!token.empty())
+            config->MaintenanceTasks.emplace_back(token);
     }
 
-    LOG_INFO("module", " ");
-    LOG_INFO("module","> ServerAutoShutdown: System loading");
+    if (config->MaintenanceEnabled && config->MaintenanceTasks.empty())
+    {
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.Maintenance.Enabled' is set but 'ServerAutoShutdown.Maintenance.Tasks' is empty, maintenance stage disabled");
+        config->MaintenanceEnabled = false;
+    }
 
-    // Cancel all task for support reload config
-    scheduler.CancelAll();
-    sWorld->ShutdownCancel();
+    if (config->MaintenanceEnabled && config->UseTimerThread)
+    {
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.Maintenance.Enabled' is not supported with 'ServerAutoShutdown.UseTimerThread', maintenance stage disabled");
+        config->MaintenanceEnabled = false;
+    }
 
-    LOG_INFO("module", "> ServerAutoShutdown: Next time to shutdown - {}", Acore::Time::TimeToHumanReadable(Seconds(nextResetTime)));
-    LOG_INFO("module", "> ServerAutoShutdown: Remaining time to shutdown - {}", Acore::Time::ToTimeString<Seconds>(diffToShutdown));
-    LOG_INFO("module", " ");
+    config->AddonEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Addon.Enabled", false);
+    config->AddonPrefix = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.Addon.Prefix", "SAS");
 
-    uint32 preAnnounceSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.PreAnnounce.Seconds", 3600);
-    if (preAnnounceSeconds > 86400)
+    // Client addon prefixes are capped at 16 characters
+    if (config->AddonEnabled && (config->AddonPrefix.empty() || config->AddonPrefix.size() > 16))
     {
-        LOG_ERROR("module", "> ServerAutoShutdown: Ahah, how could this happen? Time to preannouce has been set to more than 1 day? ({}). Change to 1 hour (3600)", preAnnounceSeconds);
-        preAnnounceSeconds = 3600;
+        LOG_ERROR("module", "> ServerAutoShutdown: Incorrect prefix in config option 'ServerAutoShutdown.Addon.Prefix' - '{}', addon countdown disabled", config->AddonPrefix);
+        config->AddonEnabled = false;
     }
 
-    uint32 timeToPreAnnounce = static_cast<uint32>(nextResetTime) - preAnnounceSeconds;
-    uint32 diffToPreAnnounce = timeToPreAnnounce - static_cast<uint32>(nowTime);
+    config->AdaptiveEnabled = sConfigMgr->GetOption<bool>("ServerAutoShutdown.Adaptive.Enabled", false);
+    config->AdaptiveMaxUptimeHours = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Adaptive.MaxUptimeHours", 0);
+    config->AdaptiveMaxRssMB = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Adaptive.MaxRssMB", 0);
+    config->AdaptiveSampleSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Adaptive.SampleSeconds", 60);
 
-    // Ingnore pre announce time and set is left
-    if (diffToShutdown < preAnnounceSeconds)
+    if (!config->AdaptiveSampleSeconds)
+        config->AdaptiveSampleSeconds = 60;
+
+    if (config->AdaptiveEnabled && !config->AdaptiveMaxUptimeHours && !config->AdaptiveMaxRssMB)
     {
-        timeToPreAnnounce = static_cast<uint32>(nowTime) + 1;
-        diffToPreAnnounce = 1;
-        preAnnounceSeconds = diffToShutdown;
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.Adaptive.Enabled' is set but both thresholds are 0, adaptive trigger disabled");
+        config->AdaptiveEnabled = false;
     }
 
-    LOG_INFO("module", "> ServerAutoShutdown: Next time to pre annouce - {}", Acore::Time::TimeToHumanReadable(Seconds(timeToPreAnnounce)));
-    LOG_INFO("module", "> ServerAutoShutdown: Remaining time to pre annouce - {}", Acore::Time::ToTimeString<Seconds>(diffToPreAnnounce));
-    LOG_INFO("module", " ");
-
-    StartPersistentGameEvents();
+    if (config->AdaptiveEnabled && config->UseTimerThread)
+    {
+        LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.Adaptive.Enabled' is not supported with 'ServerAutoShutdown.UseTimerThread', adaptive trigger disabled");
+        config->AdaptiveEnabled = false;
+    }
 
-    // Add task for pre shutdown announce
-    scheduler.Schedule(Seconds(diffToPreAnnounce), [preAnnounceSeconds](TaskContext /*context*/)
+    std::string ladder = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.PreAnnounce.Ladder", "");
+    if (!ladder.empty())
     {
-        std::string preAnnounceMessageFormat = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.PreAnnounce.Message", "[SERVER]: Automated (quick) server restart in {}");
-        std::string message = Acore::StringFormat(preAnnounceMessageFormat, Acore::Time::ToTimeString<Seconds>(preAnnounceSeconds, TimeOutput::Seconds, TimeFormat::FullText));
+        std::vector<uint32> rungs;
 
-        LOG_INFO("module", "> {}", message);
+        for (auto token : Acore::Tokenize(ladder, ' ', false))
+        {
+            if (token.empty())
+                continue;
 
-        sWorld->SendServerMessage(SERVER_MSG_STRING, message);
-        sWorld->ShutdownServ(preAnnounceSeconds, SHUTDOWN_MASK_RESTART, SHUTDOWN_EXIT_CODE);
-    });
+            auto seconds = Acore::StringTo<uint32>(token);
+            if (!seconds || !*seconds || *seconds > 86400)
+            {
+                LOG_ERROR("module", "> ServerAutoShutdown: Incorrect rung in config option 'ServerAutoShutdown.PreAnnounce.Ladder' - '{}'", token);
+                return nullptr;
+            }
+
+            rungs.emplace_back(*seconds);
+        }
+
+        std::sort(rungs.begin(), rungs.end(), [](uint32 left, uint32 right) { return left > right; });
+        rungs.erase(std::unique(rungs.begin(), rungs.end()), rungs.end());
+
+        // Format every rung message for every locale now so fire time does no
+        // string building - cost is O(rungs x locales) once at init
+        config->LadderMessages.reserve(rungs.size());
+        for (uint32 seconds : rungs)
+            config->LadderMessages.emplace_back(ServerAutoShutdownConfig::LadderRung{ seconds, std::numeric_limits<uint32>::max(), BuildAnnounceMessages(*config, seconds) });
+    }
+
+    config->LadderFullDensitySessions = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.PreAnnounce.Ladder.FullDensitySessions", 0);
+    config->LadderCoarseSeconds = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.PreAnnounce.Ladder.CoarseSeconds", 300);
+
+    if (!config->LadderCoarseSeconds)
+        config->LadderCoarseSeconds = 300;
+
+    // Precompute the thinning policy into the rung table: above the session
+    // threshold only coarse rungs plus the first and final rung broadcast.
+    // The fire path then decides with a single integer compare
+    if (config->LadderFullDensitySessions)
+    {
+        for (std::size_t i = 0; i < config->LadderMessages.size(); ++i)
+        {
+            auto& rung = config->LadderMessages[i];
+            if (i && i + 1 < config->LadderMessages.size() && rung.SecondsBefore < config->LadderCoarseSeconds)
+                rung.SessionCap = config->LadderFullDensitySessions;
+        }
+    }
+
+    return config;
 }
 
-void ServerAutoShutdown::OnUpdate(uint32 diff)
+uint64 ServerAutoShutdown::ComputeConfigHash() const
 {
-    // If module disable, why do the update? hah
-    if (!_isEnableModule)
-        return;
+    static constexpr std::array<char const*, 45> keys =
+    {
+        "ServerAutoShutdown.Enabled",
+        "ServerAutoShutdown.EveryDays",
+        "ServerAutoShutdown.Time",
+        "ServerAutoShutdown.Schedules",
+        "ServerAutoShutdown.UseTimerThread",
+        "ServerAutoShutdown.PreAnnounce.Seconds",
+        "ServerAutoShutdown.PreAnnounce.Message",
+        "ServerAutoShutdown.PreAnnounce.Ladder",
+        "ServerAutoShutdown.StartEvents",
+        "ServerAutoShutdown.PreFlush.Enabled",
+        "ServerAutoShutdown.PreFlush.BatchSize",
+        "ServerAutoShutdown.PreFlush.IntervalMs",
+        "ServerAutoShutdown.Perf.Enabled",
+        "ServerAutoShutdown.Veto.BackoffSeconds",
+        "ServerAutoShutdown.Veto.MaxExtendSeconds",
+        "ServerAutoShutdown.Stagger.Enabled",
+        "ServerAutoShutdown.Stagger.StepSeconds",
+        "ServerAutoShutdown.Stagger.MaxSlots",
+        "ServerAutoShutdown.Drain.Enabled",
+        "ServerAutoShutdown.Drain.BatchSize",
+        "ServerAutoShutdown.Drain.IntervalMs",
+        "ServerAutoShutdown.Window.Enabled",
+        "ServerAutoShutdown.Window.MaxExtendSeconds",
+        "ServerAutoShutdown.Window.MaxSessions",
+        "ServerAutoShutdown.Window.SampleSeconds",
+        "ServerAutoShutdown.Window.FireDelaySeconds",
+        "ServerAutoShutdown.Adaptive.Enabled",
+        "ServerAutoShutdown.Adaptive.MaxUptimeHours",
+        "ServerAutoShutdown.Adaptive.MaxRssMB",
+        "ServerAutoShutdown.Adaptive.SampleSeconds",
+        "ServerAutoShutdown.Addon.Enabled",
+        "ServerAutoShutdown.Addon.Prefix",
+        "ServerAutoShutdown.Maintenance.Enabled",
+        "ServerAutoShutdown.Maintenance.Tasks",
+        "ServerAutoShutdown.Maintenance.DeadlineSeconds",
+        "ServerAutoShutdown.PreUnload.Enabled",
+        "ServerAutoShutdown.PreUnload.BatchSize",
+        "ServerAutoShutdown.PreUnload.IntervalMs",
+        "ServerAutoShutdown.Webhook.Enabled",
+        "ServerAutoShutdown.Webhook.Url",
+        "ServerAutoShutdown.Webhook.TimeoutMs",
+        "ServerAutoShutdown.HotWatch.Enabled",
+        "ServerAutoShutdown.HotWatch.File",
+        "ServerAutoShutdown.PreAnnounce.Ladder.FullDensitySessions",
+        "ServerAutoShutdown.PreAnnounce.Ladder.CoarseSeconds"
+    };
+
+    std::string combined;
+    for (char const* key : keys)
+    {
+        combined += key;
+        combined += '=';
+        combined += sConfigMgr->GetOption<std::string>(key, "");
+        combined += '\n';
+    }
 
-    scheduler.Update(diff);
+    for (uint8 locale = 1; locale < TOTAL_LOCALES; ++locale)
+    {
+        combined += Acore::StringFormat("ServerAutoShutdown.PreAnnounce.Message.Locale.{}=", locale);
+        combined += sConfigMgr->GetOption<std::string>(Acore::StringFormat("ServerAutoShutdown.PreAnnounce.Message.Locale.{}", locale), "");
+        combined += '\n';
+    }
+
+    return std::hash<std::string>{}(combined);
 }
 
-void ServerAutoShutdown::StartPersistentGameEvents()
+void ServerAutoShutdown::SaveStateFile() const
 {
-    std::string eventList = sConfigMgr->GetOption<std::string>("ServerAutoShutdown.StartEvents", "");
+    auto config = GetConfig();
+    if (!config || !config->Enabled)
+        return;
 
-    std::vector<std::string_view> tokens = Acore::Tokenize(eventList, ' ', false);
-    GameEventMgr::GameEventDataMap const& events = sGameEventMgr->GetEventMap();
+    std::string buffer;
+    AppendPod<uint32>(buffer, STATE_FILE_MAGIC);
+    AppendPod<uint32>(buffer, STATE_FILE_VERSION);
+    AppendPod<uint64>(buffer, _configHash);
+
+    uint8 flags = 0;
+    flags |= config->Enabled ? 0x01 : 0;
+    flags |= config->UseTimerThread ? 0x02 : 0;
+    flags |= config->WindowEnabled ? 0x04 : 0;
+    flags |= config->PreFlushEnabled ? 0x08 : 0;
+    flags |= config->DrainEnabled ? 0x10 : 0;
+    flags |= config->StaggerEnabled ? 0x20 : 0;
+    flags |= config->PerfEnabled ? 0x40 : 0;
+    flags |= config->AdaptiveEnabled ? 0x80 : 0;
+    AppendPod<uint8>(buffer, flags);
+
+    AppendPod<uint32>(buffer, config->EveryDays);
+    AppendPod<uint8>(buffer, config->Hour);
+    AppendPod<uint8>(buffer, config->Minute);
+    AppendPod<uint8>(buffer, config->Second);
+    AppendPod<uint32>(buffer, config->PreAnnounceSeconds);
+    AppendPod<uint32>(buffer, config->PreFlushBatchSize);
+    AppendPod<uint32>(buffer, config->PreFlushIntervalMs);
+    AppendPod<uint32>(buffer, config->DrainBatchSize);
+    AppendPod<uint32>(buffer, config->DrainIntervalMs);
+    AppendPod<uint32>(buffer, config->StaggerStepSeconds);
+    AppendPod<uint32>(buffer, config->StaggerMaxSlots);
+    AppendPod<uint32>(buffer, config->VetoBackoffSeconds);
+    AppendPod<uint32>(buffer, config->VetoMaxExtendSeconds);
+    AppendPod<uint32>(buffer, config->WindowMaxExtendSeconds);
+    AppendPod<uint32>(buffer, config->WindowMaxSessions);
+    AppendPod<uint32>(buffer, config->WindowSampleSeconds);
+    AppendPod<uint32>(buffer, config->WindowFireDelaySeconds);
+    AppendPod<uint32>(buffer, config->AdaptiveMaxUptimeHours);
+    AppendPod<uint32>(buffer, config->AdaptiveMaxRssMB);
+    AppendPod<uint32>(buffer, config->AdaptiveSampleSeconds);
+    AppendPod<uint8>(buffer, config->AddonEnabled ? 1 : 0);
+    AppendString(buffer, config->AddonPrefix);
+    AppendPod<uint8>(buffer, config->WebhookEnabled ? 1 : 0);
+    AppendPod<uint32>(buffer, config->WebhookTimeoutMs);
+    AppendString(buffer, config->WebhookUrl);
+    AppendString(buffer, config->WebhookHost);
+    AppendString(buffer, config->WebhookPort);
+    AppendString(buffer, config->WebhookTarget);
+    AppendPod<uint8>(buffer, config->PreUnloadEnabled ? 1 : 0);
+    AppendPod<uint32>(buffer, config->PreUnloadBatchSize);
+    AppendPod<uint32>(buffer, config->PreUnloadIntervalMs);
+    AppendPod<uint8>(buffer, config->MaintenanceEnabled ? 1 : 0);
+    AppendPod<uint32>(buffer, config->MaintenanceDeadlineSeconds);
+    AppendPod<uint32>(buffer, static_cast<uint32>(config->MaintenanceTasks.size()));
+    for (std::string const& task : config->MaintenanceTasks)
+        AppendString(buffer, task);
+    AppendPod<uint8>(buffer, config->HotWatchEnabled ? 1 : 0);
+    AppendString(buffer, config->HotWatchFile);
+    AppendString(buffer, config->PreAnnounceMessage);
+    AppendString(buffer, config->StartEvents);
 
-    for (auto token : tokens)
+    for (std::string const& format : config->LocaleMessageFormats)
+        AppendString(buffer, format);
+
+    AppendPod<uint32>(buffer, static_cast<uint32>(config->Schedules.size()));
+    for (auto const& entry : config->Schedules)
     {
-        if (token.empty())
-        {
-            continue;
-        }
+        AppendPod<uint8>(buffer, entry.DayMask);
+        AppendPod<uint8>(buffer, entry.Hour);
+        AppendPod<uint8>(buffer, entry.Minute);
+        AppendPod<uint8>(buffer, entry.Second);
+    }
+
+    AppendPod<uint32>(buffer, config->LadderFullDensitySessions);
+    AppendPod<uint32>(buffer, config->LadderCoarseSeconds);
+    AppendPod<uint32>(buffer, static_cast<uint32>(config->LadderMessages.size()));
+    for (auto const& rung : config->LadderMessages)
+    {
+        AppendPod<uint32>(buffer, rung.SecondsBefore);
+        AppendPod<uint32>(buffer, rung.SessionCap);
+        for (std::string const& message : rung.Messages)
+            AppendString(buffer, message);
+    }
+
+    AppendPod<uint32>(buffer, static_cast<uint32>(_fireTimes.size()));
+    for (time_t fireTime : _fireTimes)
+        AppendPod<int64>(buffer, static_cast<int64>(fireTime));
 
-        uint32 eventId = *Acore::StringTo<uint32>(token);
-        sGameEventMgr->StartEvent(eventId);
+    // Crash-resume marker: the armed occurrence and whether its announce
+    // window had already opened when this file was written
+    AppendPod<uint8>(buffer, _midCountdown ? 1 : 0);
+    AppendPod<int64>(buffer, static_cast<int64>(_armedShutdownTime));
 
-        GameEventData const& eventData = events[eventId];
-        LOG_INFO("module", "> ServerAutoShutdown: Starting event {} ({}).", eventData.description, eventId);
+    std::ofstream file(GetStateFilePath(), std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        LOG_ERROR("module", "> ServerAutoShutdown: Can't write state file '{}'", GetStateFilePath());
+        return;
     }
+
+    file.write(buffer.data(), buffer.size());
+}
+
+bool ServerAutoShutdown::TryLoadStateFile(uint64 configHash, std::shared_ptr<ServerAutoShutdownConfig const>& config, std::vector<time_t>& fireTimes, time_t& resumeShutdownTime) const
+{
+    std::ifstream file(GetStateFilePath(), std::ios::binary);
+    if (!file)
+        return false;
+
+    StateReader reader;
+    reader.Buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (reader.Read<uint32>() != STATE_FILE_MAGIC || reader.Read<uint32>() != STATE_FILE_VERSION)
+        return false;
+
+    // Any config change falls back to the full parse
+    if (reader.Read<uint64>() != configHash)
+        return false;
+
+    auto loaded = std::make_shared<ServerAutoShutdownConfig>();
+
+    uint8 flags = reader.Read<uint8>();
+    loaded->Enabled = flags & 0x01;
+    loaded->UseTimerThread = flags & 0x02;
+    loaded->WindowEnabled = flags & 0x04;
+    loaded->PreFlushEnabled = flags & 0x08;
+    loaded->DrainEnabled = flags & 0x10;
+    loaded->StaggerEnabled = flags & 0x20;
+    loaded->PerfEnabled = flags & 0x40;
+    loaded->AdaptiveEnabled = flags & 0x80;
+
+    loaded->EveryDays = reader.Read<uint32>();
+    loaded->Hour = reader.Read<uint8>();
+    loaded->Minute = reader.Read<uint8>();
+    loaded->Second = reader.Read<uint8>();
+    loaded->PreAnnounceSeconds = reader.Read<uint32>();
+    loaded->PreFlushBatchSize = reader.Read<uint32>();
+    loaded->PreFlushIntervalMs = reader.Read<uint32>();
+    loaded->DrainBatchSize = reader.Read<uint32>();
+    loaded->DrainIntervalMs = reader.Read<uint32>();
+    loaded->StaggerStepSeconds = reader.Read<uint32>();
+    loaded->StaggerMaxSlots = reader.Read<uint32>();
+    loaded->VetoBackoffSeconds = reader.Read<uint32>();
+    loaded->VetoMaxExtendSeconds = reader.Read<uint32>();
+    loaded->WindowMaxExtendSeconds = reader.Read<uint32>();
+    loaded->WindowMaxSessions = reader.Read<uint32>();
+    loaded->WindowSampleSeconds = reader.Read<uint32>();
+    loaded->WindowFireDelaySeconds = reader.Read<uint32>();
+    loaded->AdaptiveMaxUptimeHours = reader.Read<uint32>();
+    loaded->AdaptiveMaxRssMB = reader.Read<uint32>();
+    loaded->AdaptiveSampleSeconds = reader.Read<uint32>();
+    loaded->AddonEnabled = reader.Read<uint8>() != 0;
+    loaded->AddonPrefix = reader.ReadString();
+    loaded->WebhookEnabled = reader.Read<uint8>() != 0;
+    loaded->WebhookTimeoutMs = reader.Read<uint32>();
+    loaded->WebhookUrl = reader.ReadString();
+    loaded->WebhookHost = reader.ReadString();
+    loaded->WebhookPort = reader.ReadString();
+    loaded->WebhookTarget = reader.ReadString();
+    loaded->PreUnloadEnabled = reader.Read<uint8>() != 0;
+    loaded->PreUnloadBatchSize = reader.Read<uint32>();
+    loaded->PreUnloadIntervalMs = reader.Read<uint32>();
+    loaded->MaintenanceEnabled = reader.Read<uint8>() != 0;
+    loaded->MaintenanceDeadlineSeconds = reader.Read<uint32>();
+
+    uint32 maintenanceTaskCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < maintenanceTaskCount && reader.Ok; ++i)
+        loaded->MaintenanceTasks.emplace_back(reader.ReadString());
+
+    loaded->HotWatchEnabled = reader.Read<uint8>() != 0;
+    loaded->HotWatchFile = reader.ReadString();
+    loaded->PreAnnounceMessage = reader.ReadString();
+    loaded->StartEvents = reader.ReadString();
+
+    for (uint8 locale = 0; locale < TOTAL_LOCALES; ++locale)
+    {
+        loaded->LocaleMessageFormats[locale] = reader.ReadString();
+        if (locale != DEFAULT_LOCALE && !loaded->LocaleMessageFormats[locale].empty())
+            loaded->HasLocalizedMessages = true;
+    }
+
+    uint32 scheduleCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < scheduleCount && reader.Ok; ++i)
+    {
+        ShutdownScheduleEntry entry;
+        entry.DayMask = reader.Read<uint8>();
+        entry.Hour = reader.Read<uint8>();
+        entry.Minute = reader.Read<uint8>();
+        entry.Second = reader.Read<uint8>();
+        loaded->Schedules.emplace_back(entry);
+    }
+
+    loaded->LadderFullDensitySessions = reader.Read<uint32>();
+    loaded->LadderCoarseSeconds = reader.Read<uint32>();
+
+    uint32 ladderCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < ladderCount && reader.Ok; ++i)
+    {
+        ServerAutoShutdownConfig::LadderRung rung;
+        rung.SecondsBefore = reader.Read<uint32>();
+        rung.SessionCap = reader.Read<uint32>();
+        for (std::string& message : rung.Messages)
+            message = reader.ReadString();
+
+        loaded->LadderMessages.emplace_back(std::move(rung));
+    }
+
+    std::vector<time_t> loadedFireTimes;
+    uint32 fireTimeCount = reader.Read<uint32>();
+    for (uint32 i = 0; i < fireTimeCount && reader.Ok; ++i)
+        loadedFireTimes.emplace_back(static_cast<time_t>(reader.Read<int64>()));
+
+    uint8 midCountdown = reader.Read<uint8>();
+    int64 armedShutdownTime = reader.Read<int64>();
+
+    if (!reader.Ok || !loaded->Enabled)
+        return false;
+
+    // A crash inside the announce window leaves the marker set: resume that
+    // occurrence - even when its fire time passed while the server was down -
+    // instead of pushing the restart to the next scheduled day
+    if (midCountdown && armedShutdownTime)
+        resumeShutdownTime = static_cast<time_t>(armedShutdownTime);
+
+    // Only future occurrences are usable; an empty table means the file is
+    // exhausted and the schedule has to be re-derived
+    time_t nowTime = time(nullptr);
+    loadedFireTimes.erase(std::remove_if(loadedFireTimes.begin(), loadedFireTimes.end(),
+        [nowTime](time_t fireTime) { return fireTime <= nowTime + 10; }), loadedFireTimes.end());
+
+    if (loadedFireTimes.empty())
+    {
+        if (!resumeShutdownTime)
+            return false;
+
+        // The crashed occurrence was the last one in the table: carry it
+        // over so the apply path has something to arm
+        loadedFireTimes.assign(1, resumeShutdownTime);
+    }
+
+    config = std::move(loaded);
+    fireTimes = std::move(loadedFireTimes);
+    return true;
+}
+
+void ServerAutoShutdown::RecordRestartTelemetry(uint32 delaySeconds) const
+{
+    if (_simActive || !IsTelemetryEnabled())
+        return;
+
+    std::fstream file;
+    uint32 capacity = 0;
+    uint32 head = 0;
+    if (!OpenTelemetryFile(file, capacity, head))
+        return;
+
+    ServerAutoShutdownRestartRecord record;
+    record.ScheduledFireTime = static_cast<int64>(_armedShutdownTime);
+
+    // Plain wall clock, not WallNow(): the resync anchors are only set on
+    // the wheel path, and telemetry also records in timer thread mode (the
+    // sim already returned above, so there is no virtual clock to honor)
+    record.RequestedFireTime = static_cast<int64>(time(nullptr));
+    record.CountdownSeconds = delaySeconds;
+    record.SessionsAtPreAnnounce = _telemetrySessionsAtPreAnnounce;
+    record.SessionsAtFire = sWorld->GetActiveSessionCount();
+
+    WriteTelemetryRecord(file, head, record);
+
+    head = (head + 1) % capacity;
+    file.seekp(12);
+    file.write(reinterpret_cast<char const*>(&head), sizeof(head));
+}
+
+void ServerAutoShutdown::RecordTelemetryExit() const
+{
+    if (!IsTelemetryEnabled())
+        return;
+
+    std::fstream file;
+    uint32 capacity = 0;
+    uint32 head = 0;
+    if (!OpenTelemetryFile(file, capacity, head))
+        return;
+
+    // Stamp the exit time into the record written when the restart fired;
+    // the next startup turns the pair into a measured shutdown duration
+    uint32 last = (head + capacity - 1) % capacity;
+
+    ServerAutoShutdownRestartRecord record;
+    if (!ReadTelemetryRecord(file, last, record) || !record.RequestedFireTime || record.Complete)
+        return;
+
+    record.ExitTime = static_cast<int64>(time(nullptr));
+    WriteTelemetryRecord(file, last, record);
+}
+
+void ServerAutoShutdown::FinalizeRestartTelemetry() const
+{
+    if (!IsTelemetryEnabled())
+        return;
+
+    std::fstream file;
+    uint32 capacity = 0;
+    uint32 head = 0;
+    if (!OpenTelemetryFile(file, capacity, head))
+        return;
+
+    uint32 last = (head + capacity - 1) % capacity;
+
+    ServerAutoShutdownRestartRecord record;
+    if (!ReadTelemetryRecord(file, last, record) || !record.RequestedFireTime || record.Complete || !record.ExitTime)
+        return;
+
+    // Wall clock cost of the actual teardown: countdown expiry to the last
+    // write the exiting process managed. This is the number the announce and
+    // drain windows should be sized against
+    int64 countdownExpiry = record.RequestedFireTime + record.CountdownSeconds;
+    record.ShutdownDurationSeconds = record.ExitTime > countdownExpiry ? static_cast<uint32>(record.ExitTime - countdownExpiry) : 0;
+    record.Complete = true;
+    WriteTelemetryRecord(file, last, record);
+
+    LOG_INFO("module", "> ServerAutoShutdown: Previous restart took {} seconds from countdown expiry to process exit ({} sessions at fire)",
+        record.ShutdownDurationSeconds, record.SessionsAtFire);
+}
+
+std::vector<ServerAutoShutdownRestartRecord> ServerAutoShutdown::GetRestartTelemetry() const
+{
+    std::vector<ServerAutoShutdownRestartRecord> records;
+
+    if (!IsTelemetryEnabled())
+        return records;
+
+    std::fstream file;
+    uint32 capacity = 0;
+    uint32 head = 0;
+    if (!OpenTelemetryFile(file, capacity, head))
+        return records;
+
+    // Walk the ring oldest to newest; untouched slots are all-zero
+    for (uint32 offset = 0; offset < capacity; ++offset)
+    {
+        ServerAutoShutdownRestartRecord record;
+        if (ReadTelemetryRecord(file, (head + offset) % capacity, record) && record.RequestedFireTime)
+            records.emplace_back(record);
+    }
+
+    return records;
+}
+
+void ServerAutoShutdown::Init()
+{
+    ApplyScheduleData(BuildScheduleData());
+}
+
+void ServerAutoShutdown::InitAsync()
+{
+    // One detached worker per reload; the mailbox is last-writer-wins, so a
+    // second .reload config while the first still computes is harmless
+    std::thread([this] { BuildAndPublishScheduleData(); }).detach();
+}
+
+void ServerAutoShutdown::BuildAndPublishScheduleData()
+{
+    auto data = std::make_shared<ShutdownScheduleData>(BuildScheduleData());
+    std::atomic_store_explicit(&_pendingInit, std::move(data), std::memory_order_release);
+    _hasPendingInit.store(true, std::memory_order_release);
+}
+
+void ServerAutoShutdown::ProcessPendingInit()
+{
+    // Hot-watch handoff: refreshing the option cache is only safe here, on
+    // the world thread, between GetOption readers. The expensive parse and
+    // rebuild still run off-thread and land in the mailbox below
+    if (_pendingConfigReload.load(std::memory_order_acquire))
+    {
+        _pendingConfigReload.store(false, std::memory_order_relaxed);
+        sConfigMgr->LoadModulesConfigs(true, false);
+        InitAsync();
+    }
+
+    // One atomic load per tick until an async reload result is waiting
+    if (!_hasPendingInit.load(std::memory_order_acquire))
+        return;
+
+    _hasPendingInit.store(false, std::memory_order_relaxed);
+
+    if (auto pending = std::atomic_exchange_explicit(&_pendingInit, std::shared_ptr<ShutdownScheduleData>(), std::memory_order_acq_rel))
+        ApplyScheduleData(std::move(*pending));
+}
+
+ShutdownScheduleData ServerAutoShutdown::BuildScheduleData() const
+{
+    ShutdownScheduleData data;
+    data.ConfigHash = ComputeConfigHash();
+
+    // Warm path: if config did not change since the state file was written,
+    // re-arm from the persisted snapshot and fire table without re-deriving
+    data.WarmLoaded = !_simActive && TryLoadStateFile(data.ConfigHash, data.Config, data.FireTimes, data.ResumeShutdownTime);
+
+    if (!data.WarmLoaded)
+        data.Config = LoadConfig();
+
+    if (!data.Config || !data.Config->Enabled)
+        return data;
+
+    auto const& config = data.Config;
+    time_t nowTime = EpochNow();
+
+    if (data.WarmLoaded)
+        LOG_INFO("module", "> ServerAutoShutdown: Re-armed from state file '{}'", GetStateFilePath());
+    else if (!config->Schedules.empty())
+    {
+        // Expand every schedule entry once; afterwards "next shutdown" is the
+        // front of a sorted epoch array, no tm/mktime work at runtime
+        data.FireTimes = ExpandFireTimes(config->Schedules, nowTime, 14);
+        if (data.FireTimes.empty())
+        {
+            // Empty fire table disables the module in ApplyScheduleData
+            LOG_ERROR("module", "> ServerAutoShutdown: 'ServerAutoShutdown.Schedules' produced no upcoming occurrence");
+            return data;
+        }
+    }
+    else
+    {
+        time_t nextResetTime = GetNextResetTime(nowTime, config->EveryDays, config->Hour, config->Minute, config->Second);
+
+        if (nextResetTime - nowTime < 10)
+        {
+            LOG_WARN("module", "> ServerAutoShutdown: Next time to shutdown < 10 seconds, Set next day");
+            nextResetTime += 86400 * config->EveryDays;
+        }
+
+        // Persist the same 14 day horizon the Schedules path expands: a
+        // single occurrence is already in the past on the boot that follows
+        // the restart, and the warm re-arm would never engage
+        time_t horizon = nowTime + 14 * DAY;
+        for (time_t occurrence = nextResetTime; occurrence <= horizon; occurrence += time_t(86400) * config->EveryDays)
+            data.FireTimes.emplace_back(occurrence);
+
+        // A cadence beyond the horizon still keeps its armed occurrence
+        if (data.FireTimes.empty())
+            data.FireTimes.assign(1, nextResetTime);
+    }
+
+    // Multi-realm staggering: claim a slot for this maintenance window in the
+    // shared auth DB and delay this realm accordingly. The fire table keeps
+    // the base schedule, only the armed occurrence is offset
+    if (config->StaggerEnabled && !_simActive && !data.ResumeShutdownTime)
+    {
+        uint32 slot = ClaimRestartSlot(data.FireTimes.front(), config->StaggerMaxSlots);
+        if (slot)
+        {
+            data.StaggerOffsetSeconds = slot * config->StaggerStepSeconds;
+            LOG_INFO("module", "> ServerAutoShutdown: Claimed restart slot {}, shutdown delayed by {} seconds", slot, data.StaggerOffsetSeconds);
+        }
+    }
+
+    return data;
+}
+
+void ServerAutoShutdown::ApplyScheduleData(ShutdownScheduleData data)
+{
+    auto applyStart = std::chrono::steady_clock::now();
+
+    // A reload can't switch the drive mode - the WorldScript variant was
+    // fixed at registration. Rewrite a flipped snapshot to the registered
+    // mode before anything consumes it: the event starts, the pipelines and
+    // the window gate all branch on the snapshot's own flags, and arming
+    // them against the wrong mode silently loses the restart
+    if (!_simActive && data.Config && data.Config->Enabled && data.Config->UseTimerThread != _scriptTimerThreadMode)
+    {
+        LOG_ERROR("module", "> ServerAutoShutdown: 'ServerAutoShutdown.UseTimerThread' changed on reload, but switching needs a worldserver restart - keeping {} mode",
+            _scriptTimerThreadMode ? "timer thread" : "timer wheel");
+
+        auto corrected = std::make_shared<ServerAutoShutdownConfig>(*data.Config);
+        corrected->UseTimerThread = _scriptTimerThreadMode;
+
+        // Strip what LoadConfig would have stripped had it parsed the
+        // snapshot in timer thread mode
+        if (_scriptTimerThreadMode)
+        {
+            corrected->WindowEnabled = false;
+            corrected->PreFlushEnabled = false;
+            corrected->DrainEnabled = false;
+            corrected->PreUnloadEnabled = false;
+            corrected->MaintenanceEnabled = false;
+            corrected->AdaptiveEnabled = false;
+        }
+
+        data.Config = std::move(corrected);
+    }
+
+    _configHash = data.ConfigHash;
+    _perfEnabled = data.Config && data.Config->PerfEnabled;
+
+    // Publish the snapshot atomically so tasks armed before a reload never
+    // observe half-updated options
+    std::atomic_store_explicit(&_config, data.Config, std::memory_order_release);
+
+    _isEnableModule = data.Config && data.Config->Enabled && !data.FireTimes.empty();
+    if (!_isEnableModule)
+    {
+        // A reload may have just disabled the module: stand down armed slots
+        // and the timer-thread deadline, or the parked thread would still
+        // trip the old one and restart a realm that asked it not to
+        _timers.CancelAll();
+
+        if (_useTimerThread)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_timerMutex);
+                _timerDeadline = 0;
+                ++_timerGeneration;
+                _pendingTimerFire.store(false, std::memory_order_relaxed);
+            }
+            _timerCondVar.notify_one();
+        }
+
+        // The watcher outlives a disabling edit so the file can turn the
+        // module back on; it only goes down when its own option is off
+        if (!_simActive && data.Config)
+        {
+            if (data.Config->HotWatchEnabled)
+                StartConfigWatchThread(data.Config->HotWatchFile);
+            else
+                StopConfigWatchThread();
+        }
+
+        return;
+    }
+
+    auto config = data.Config;
+    _fireTimes = std::move(data.FireTimes);
+
+    time_t nowTime = EpochNow();
+    uint64 nextResetTime = uint64(_fireTimes.front()) + data.StaggerOffsetSeconds;
+
+    // The previous run died inside its announce window: pick the countdown
+    // back up instead of deferring the occurrence. A fire time that passed
+    // while the server was down completes after a short grace countdown,
+    // so the maintenance window is served late rather than skipped
+    if (data.ResumeShutdownTime)
+    {
+        nextResetTime = static_cast<uint64>(std::max<time_t>(data.ResumeShutdownTime, nowTime + 60));
+        LOG_WARN("module", "> ServerAutoShutdown: Previous run ended mid-countdown, resuming the pending restart at {}", Acore::Time::TimeToHumanReadable(Seconds(nextResetTime)));
+    }
+
+    uint32 diffToShutdown = nextResetTime - static_cast<uint32>(nowTime);
+
+    LOG_INFO("module", " ");
+    LOG_INFO("module","> ServerAutoShutdown: System loading");
+
+    // Cancel all task for support reload config
+    _timers.CancelAll();
+    if (!_simActive)
+        sWorld->ShutdownCancel();
+    _preFlushActive = false;
+    _drainActive = false;
+    _preUnloadActive = false;
+    _maintenanceActive = false;
+    _maintenanceTaskRunning = false;
+    ++_maintenanceGeneration;
+    _vetoGiveUpTime = 0;
+    _telemetrySessionsAtPreAnnounce = 0;
+    _midCountdown = false;
+
+    // Context the wheel callbacks will fire against
+    _armedConfig = config;
+    _armedShutdownTime = static_cast<time_t>(nextResetTime);
+
+    LOG_INFO("module", "> ServerAutoShutdown: Next time to shutdown - {}", Acore::Time::TimeToHumanReadable(Seconds(nextResetTime)));
+    LOG_INFO("module", "> ServerAutoShutdown: Remaining time to shutdown - {}", Acore::Time::ToTimeString<Seconds>(diffToShutdown));
+    LOG_INFO("module", " ");
+
+    uint32 preAnnounceSeconds = config->PreAnnounceSeconds;
+
+    uint32 timeToPreAnnounce = static_cast<uint32>(nextResetTime) - preAnnounceSeconds;
+    uint32 diffToPreAnnounce = timeToPreAnnounce - static_cast<uint32>(nowTime);
+
+    // Ingnore pre announce time and set is left
+    if (diffToShutdown < preAnnounceSeconds)
+    {
+        timeToPreAnnounce = static_cast<uint32>(nowTime) + 1;
+        diffToPreAnnounce = 1;
+        preAnnounceSeconds = diffToShutdown;
+    }
+
+    LOG_INFO("module", "> ServerAutoShutdown: Next time to pre annouce - {}", Acore::Time::TimeToHumanReadable(Seconds(timeToPreAnnounce)));
+    LOG_INFO("module", "> ServerAutoShutdown: Remaining time to pre annouce - {}", Acore::Time::ToTimeString<Seconds>(diffToPreAnnounce));
+    LOG_INFO("module", " ");
+
+    // Format the pre announce for every locale now; the adjusted seconds are
+    // only known here, not at config load
+    _armedPreAnnounceSeconds = preAnnounceSeconds;
+    _armedPreAnnounceMessages = BuildAnnounceMessages(*config, preAnnounceSeconds);
+    BuildAddonPackets(config);
+
+    if (!_simActive)
+    {
+        BuildPersistentEventCache(config);
+        StartPersistentGameEvents();
+
+        // Keep the state file current so the next startup can re-arm from it
+        SaveStateFile();
+
+        NotifyLifecycleEvent(WEBHOOK_SCHEDULE_ARMED);
+
+        // Pick up edits to the module config file without a .reload config;
+        // a snapshot that turned the option off takes the watcher down too
+        if (config->HotWatchEnabled)
+            StartConfigWatchThread(config->HotWatchFile);
+        else
+            StopConfigWatchThread();
+    }
+
+    // The simulation always runs the wheel path, never the real thread.
+    // The snapshot was already rewritten to the registered script's mode
+    _useTimerThread = config->UseTimerThread && !_simActive;
+    if (_useTimerThread)
+    {
+        if (!config->LadderMessages.empty())
+            LOG_WARN("module", "> ServerAutoShutdown: 'ServerAutoShutdown.PreAnnounce.Ladder' is not supported with 'ServerAutoShutdown.UseTimerThread', using single pre announce");
+
+        // The deadline wait lives on the background thread, the world thread
+        // only pays one atomic load per tick to drain the fire mailbox
+        ArmTimerThread(static_cast<time_t>(timeToPreAnnounce));
+        _perfLastInitNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - applyStart).count(), std::memory_order_relaxed);
+        return;
+    }
+
+    // Anchor the clock pair first: everything armed below runs on elapsed
+    // time and is re-derived from these anchors between resyncs
+    _lastResyncWall = nowTime;
+    _simRestartAt = 0;
+    _lastResyncSteady = std::chrono::steady_clock::now();
+
+    // Low-population window: announces still go out as usual, but the actual
+    // ShutdownServ is issued by the window gate at the population trough
+    if (config->WindowEnabled)
+        ArmShutdownWindow();
+
+    // Countdown ladder: the module announces every rung itself with prebuilt
+    // strings, World takes over only for the final rung
+    if (!config->LadderMessages.empty())
+        ArmLadderRung(0);
+    else
+        _timers.ArmAt(TIMER_PRE_ANNOUNCE, static_cast<time_t>(timeToPreAnnounce), nowTime, 0, &ServerAutoShutdown::FirePreAnnounce);
+
+    // Keep the absolute slots honest against wall clock steps
+    _timers.Arm(TIMER_CLOCK_RESYNC, CLOCK_RESYNC_INTERVAL_MS, CLOCK_RESYNC_INTERVAL_MS, &ServerAutoShutdown::FireClockResync);
+
+    // Adaptive trigger: one cheap uptime/RSS sample per interval, pulling the
+    // restart forward when the process degrades before the scheduled time.
+    // The simulation has no real process to sample
+    if (config->AdaptiveEnabled && !_simActive)
+        _timers.Arm(TIMER_ADAPTIVE, uint64(config->AdaptiveSampleSeconds) * IN_MILLISECONDS, uint64(config->AdaptiveSampleSeconds) * IN_MILLISECONDS, &ServerAutoShutdown::FireAdaptiveCheck);
+
+    ArmSchedulerGate(static_cast<uint32>(_timers.MsToNextFire(IDLE_GATE_MS)));
+
+    _perfLastInitNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - applyStart).count(), std::memory_order_relaxed);
+}
+
+/*static*/ void ServerAutoShutdown::FirePreAnnounce(ServerAutoShutdown& self)
+{
+    self.DoPreAnnounce(self._armedConfig);
+}
+
+void ServerAutoShutdown::ArmShutdownWindow()
+{
+    _windowEnd = _armedShutdownTime + _armedConfig->WindowMaxExtendSeconds;
+
+    // Absolute first fire at the scheduled time, relative sampling afterwards
+    _timers.ArmAt(TIMER_WINDOW_GATE, _armedShutdownTime, EpochNow(), uint64(_armedConfig->WindowSampleSeconds) * IN_MILLISECONDS, &ServerAutoShutdown::FireWindowGate);
+}
+
+/*static*/ void ServerAutoShutdown::FireWindowGate(ServerAutoShutdown& self)
+{
+    auto const& config = self._armedConfig;
+
+    // The simulation has no sessions: the window fires at its earliest point
+    if (self._simActive)
+    {
+        self.SimRecord(Acore::StringFormat("window gate fires, ShutdownServ({})", config->WindowFireDelaySeconds));
+        self.SimShutdown(config->WindowFireDelaySeconds);
+        self._timers.Cancel(TIMER_WINDOW_GATE);
+        return;
+    }
+
+    // One GetActiveSessionCount call per sample interval, cached for any
+    // other consumer - never polled from a tight loop
+    uint32 sessions = sWorld->GetActiveSessionCount();
+    self._cachedSessionCount.store(sessions, std::memory_order_relaxed);
+
+    if (sessions > config->WindowMaxSessions && self.WallNow() < self._windowEnd)
+        return;
+
+    if (sessions > config->WindowMaxSessions)
+        LOG_WARN("module", "> ServerAutoShutdown: Low-population window expired with {} sessions online, restarting anyway", sessions);
+    else
+        LOG_INFO("module", "> ServerAutoShutdown: Population dropped to {} sessions, firing restart", sessions);
+
+    self.RequestShutdown(config->WindowFireDelaySeconds);
+    self._timers.Cancel(TIMER_WINDOW_GATE);
+}
+
+bool ServerAutoShutdown::RearmOccurrence(time_t shutdownTime)
+{
+    if (!_isEnableModule || !_armedConfig)
+        return false;
+
+    auto config = _armedConfig;
+    time_t nowTime = _useTimerThread ? EpochNow() : WallNow();
+
+    // Same guard as Init(): never arm closer than 10 seconds out
+    if (shutdownTime <= nowTime + 10)
+        return false;
+
+    // Stand down only the slots of the armed occurrence; the clock resync
+    // and adaptive probe keep their cadence
+    _timers.Cancel(TIMER_PRE_ANNOUNCE);
+    _timers.Cancel(TIMER_LADDER);
+    _timers.Cancel(TIMER_WINDOW_GATE);
+    _timers.Cancel(TIMER_PRE_FLUSH);
+    _timers.Cancel(TIMER_DRAIN);
+    _timers.Cancel(TIMER_MAINTENANCE);
+    _timers.Cancel(TIMER_PRE_UNLOAD);
+    _timers.Cancel(TIMER_VETO_RETRY);
+    sWorld->ShutdownCancel();
+    _preFlushActive = false;
+    _drainActive = false;
+    _preUnloadActive = false;
+    _maintenanceActive = false;
+    _maintenanceTaskRunning = false;
+    ++_maintenanceGeneration;
+    _vetoGiveUpTime = 0;
+    _telemetrySessionsAtPreAnnounce = 0;
+    _midCountdown = false;
+
+    _armedShutdownTime = shutdownTime;
+
+    uint32 preAnnounceSeconds = config->PreAnnounceSeconds;
+    uint32 diffToShutdown = static_cast<uint32>(shutdownTime - nowTime);
+    time_t timeToPreAnnounce = shutdownTime - static_cast<time_t>(preAnnounceSeconds);
+
+    if (diffToShutdown < preAnnounceSeconds)
+    {
+        timeToPreAnnounce = nowTime + 1;
+        preAnnounceSeconds = diffToShutdown;
+    }
+
+    _armedPreAnnounceSeconds = preAnnounceSeconds;
+    _armedPreAnnounceMessages = BuildAnnounceMessages(*config, preAnnounceSeconds);
+    BuildAddonPackets(config);
+
+    if (_useTimerThread)
+    {
+        ArmTimerThread(timeToPreAnnounce);
+        return true;
+    }
+
+    if (config->WindowEnabled)
+        ArmShutdownWindow();
+
+    if (!config->LadderMessages.empty())
+        ArmLadderRung(0);
+    else
+        _timers.ArmAt(TIMER_PRE_ANNOUNCE, timeToPreAnnounce, nowTime, 0, &ServerAutoShutdown::FirePreAnnounce);
+
+    ArmSchedulerGate(static_cast<uint32>(_timers.MsToNextFire(IDLE_GATE_MS)));
+    return true;
+}
+
+bool ServerAutoShutdown::Reschedule(time_t shutdownTime)
+{
+    if (!RearmOccurrence(shutdownTime))
+        return false;
+
+    // Keep the fire table and state file in step with the moved occurrence:
+    // entries the move jumped over are served by it, so drop them - the
+    // armed time must stay at the front, or GetNextShutdownTime() and the
+    // persisted schedule would report an occurrence nothing has armed
+    _fireTimes.erase(std::remove_if(_fireTimes.begin(), _fireTimes.end(),
+        [shutdownTime](time_t fireTime) { return fireTime <= shutdownTime; }), _fireTimes.end());
+    _fireTimes.insert(_fireTimes.begin(), shutdownTime);
+
+    SaveStateFile();
+
+    LOG_INFO("module", "> ServerAutoShutdown: Rescheduled, next time to shutdown - {}", Acore::Time::TimeToHumanReadable(Seconds(shutdownTime)));
+    return true;
+}
+
+bool ServerAutoShutdown::RescheduleTimeOfDay(uint8 hour, uint8 minute, uint8 second)
+{
+    return Reschedule(GetNextResetTime(EpochNow(), 1, hour, minute, second));
+}
+
+bool ServerAutoShutdown::Postpone(Seconds delay)
+{
+    if (!_armedShutdownTime)
+        return false;
+
+    return Reschedule(_armedShutdownTime + static_cast<time_t>(delay.count()));
+}
+
+bool ServerAutoShutdown::CancelNext()
+{
+    if (!_isEnableModule || _fireTimes.empty())
+        return false;
+
+    _fireTimes.erase(_fireTimes.begin());
+
+    if (!_fireTimes.empty() && RearmOccurrence(_fireTimes.front()))
+        LOG_INFO("module", "> ServerAutoShutdown: Next shutdown cancelled, following occurrence - {}", Acore::Time::TimeToHumanReadable(Seconds(_fireTimes.front())));
+    else
+    {
+        // No further occurrence in the horizon: stand everything down until
+        // the next startup or .reload config
+        _timers.CancelAll();
+        sWorld->ShutdownCancel();
+
+        if (_useTimerThread)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_timerMutex);
+                _timerDeadline = 0;
+                ++_timerGeneration;
+                _pendingTimerFire.store(false, std::memory_order_relaxed);
+            }
+            _timerCondVar.notify_one();
+        }
+
+        _isEnableModule = false;
+        _midCountdown = false;
+        LOG_WARN("module", "> ServerAutoShutdown: Next shutdown cancelled, no further occurrence armed - reload the config to re-arm");
+    }
+
+    SaveStateFile();
+    return true;
+}
+
+ShutdownVetoCounter* ServerAutoShutdown::RegisterShutdownVeto(std::string name)
+{
+    std::lock_guard<std::mutex> lock(_vetoMutex);
+    _vetoCounters.emplace_back(std::make_unique<ShutdownVetoCounter>(std::move(name)));
+    return _vetoCounters.back().get();
+}
+
+ShutdownVetoCounter const* ServerAutoShutdown::ActiveVeto()
+{
+    // Called once per shutdown attempt, not per tick - the lock only
+    // serializes against late registrations
+    std::lock_guard<std::mutex> lock(_vetoMutex);
+    for (auto const& counter : _vetoCounters)
+        if (counter->Count.load(std::memory_order_relaxed) > 0)
+            return counter.get();
+
+    return nullptr;
+}
+
+void ServerAutoShutdown::RequestShutdown(uint32 delaySeconds)
+{
+    if (_simActive)
+    {
+        SimShutdown(delaySeconds);
+        return;
+    }
+
+    // Veto backoff: while something like a raid encounter is live, retry
+    // later instead of kicking everyone mid-boss. Bounded so a stuck counter
+    // cannot block maintenance forever. Timer thread mode never ticks the
+    // wheel, so the retry slot cannot work there and vetoes are ignored
+    if (!_useTimerThread)
+        if (ShutdownVetoCounter const* veto = ActiveVeto())
+        {
+            time_t nowTime = WallNow();
+            if (!_vetoGiveUpTime)
+                _vetoGiveUpTime = nowTime + _armedConfig->VetoMaxExtendSeconds;
+
+            if (nowTime < _vetoGiveUpTime)
+            {
+                LOG_INFO("module", "> ServerAutoShutdown: Restart vetoed by '{}' ({} active), retrying in {} seconds", veto->Name, veto->Count.load(std::memory_order_relaxed), _armedConfig->VetoBackoffSeconds);
+                _pendingShutdownDelay = delaySeconds;
+                _timers.Arm(TIMER_VETO_RETRY, uint64(_armedConfig->VetoBackoffSeconds) * IN_MILLISECONDS, 0, &ServerAutoShutdown::FireVetoRetry);
+                return;
+            }
+
+            LOG_WARN("module", "> ServerAutoShutdown: Veto '{}' still active after {} seconds of backoff, restarting anyway", veto->Name, _armedConfig->VetoMaxExtendSeconds);
+        }
+
+    RecordRestartTelemetry(delaySeconds);
+    NotifyLifecycleEvent(WEBHOOK_SHUTDOWN_FIRED);
+    sWorld->ShutdownServ(delaySeconds, SHUTDOWN_MASK_RESTART, SHUTDOWN_EXIT_CODE);
+
+    // World owns the restart from here: clear the crash-resume marker so the
+    // post-restart boot arms the next occurrence, not this one again
+    _midCountdown = false;
+    SaveStateFile();
+}
+
+/*static*/ void ServerAutoShutdown::FireVetoRetry(ServerAutoShutdown& self)
+{
+    self.RequestShutdown(self._pendingShutdownDelay);
+}
+
+/*static*/ void ServerAutoShutdown::FireAdaptiveCheck(ServerAutoShutdown& self)
+{
+    auto const& config = self._armedConfig;
+    time_t nowTime = self.WallNow();
+
+    // The scheduled restart is already inside its announce window - let the
+    // normal pipeline handle it and stop sampling
+    if (self._armedShutdownTime - nowTime <= time_t(self._armedPreAnnounceSeconds))
+    {
+        self._timers.Cancel(TIMER_ADAPTIVE);
+        return;
+    }
+
+    uint32 uptimeHours = static_cast<uint32>(GameTime::GetUptime().count() / HOUR);
+    uint32 rssMB = config->AdaptiveMaxRssMB ? GetResidentSetMB() : 0;
+
+    bool uptimeHit = config->AdaptiveMaxUptimeHours && uptimeHours >= config->AdaptiveMaxUptimeHours;
+    bool rssHit = config->AdaptiveMaxRssMB && rssMB && rssMB >= config->AdaptiveMaxRssMB;
+
+    if (!uptimeHit && !rssHit)
+        return;
+
+    if (uptimeHit)
+        LOG_WARN("module", "> ServerAutoShutdown: Adaptive trigger hit (uptime {} h >= {} h), pulling the restart forward", uptimeHours, config->AdaptiveMaxUptimeHours);
+    else
+        LOG_WARN("module", "> ServerAutoShutdown: Adaptive trigger hit (RSS {} MB >= {} MB), pulling the restart forward", rssMB, config->AdaptiveMaxRssMB);
+
+    // Re-target the armed occurrence at the end of a fresh announce window;
+    // the prebuilt announce messages still match _armedPreAnnounceSeconds.
+    // The scheduled announce/ladder slots are stood down, and with the
+    // low-population window enabled the pulled-forward restart still waits
+    // for the next trough instead of firing into a full realm
+    self._timers.Cancel(TIMER_ADAPTIVE);
+    self._timers.Cancel(TIMER_PRE_ANNOUNCE);
+    self._timers.Cancel(TIMER_LADDER);
+    self._timers.Cancel(TIMER_WINDOW_GATE);
+
+    self._armedShutdownTime = nowTime + time_t(self._armedPreAnnounceSeconds);
+
+    if (config->WindowEnabled)
+        self.ArmShutdownWindow();
+
+    self.DoPreAnnounce(config);
+}
+
+void ServerAutoShutdown::StartPreFlushPipeline()
+{
+    if (_simActive)
+        return;
+
+    LOG_INFO("module", "> ServerAutoShutdown: Starting pre-shutdown save pipeline ({} players per {} ms)", _armedConfig->PreFlushBatchSize, _armedConfig->PreFlushIntervalMs);
+
+    _preFlushActive = true;
+    _preFlushGuids.clear();
+    _preFlushCursor = 0;
+    _timers.Arm(TIMER_PRE_FLUSH, _armedConfig->PreFlushIntervalMs, _armedConfig->PreFlushIntervalMs, &ServerAutoShutdown::FirePreFlushBatch);
+}
+
+/*static*/ void ServerAutoShutdown::FirePreFlushBatch(ServerAutoShutdown& self)
+{
+    auto const& config = self._armedConfig;
+
+    // Exhausted the previous pass: take a fresh snapshot of online players
+    // and start over, so state dirtied during the window is flushed too
+    if (self._preFlushCursor >= self._preFlushGuids.size())
+    {
+        self._preFlushGuids.clear();
+        self._preFlushCursor = 0;
+
+        for (auto const& [accountId, session] : sWorld->GetAllSessions())
+            if (Player* player = session->GetPlayer())
+                if (player->IsInWorld())
+                    self._preFlushGuids.emplace_back(player->GetGUID());
+    }
+
+    uint32 saved = 0;
+    while (self._preFlushCursor < self._preFlushGuids.size() && saved < config->PreFlushBatchSize)
+    {
+        if (Player* player = ObjectAccessor::FindPlayer(self._preFlushGuids[self._preFlushCursor]))
+        {
+            player->SaveToDB(false, false);
+            ++saved;
+        }
+
+        ++self._preFlushCursor;
+    }
+}
+
+void ServerAutoShutdown::StartDrainPipeline()
+{
+    if (_simActive)
+        return;
+
+    LOG_INFO("module", "> ServerAutoShutdown: Starting idle session drain ({} sessions per {} ms)", _armedConfig->DrainBatchSize, _armedConfig->DrainIntervalMs);
+
+    _drainActive = true;
+    _drainAccountIds.clear();
+    _drainCursor = 0;
+    _timers.Arm(TIMER_DRAIN, _armedConfig->DrainIntervalMs, _armedConfig->DrainIntervalMs, &ServerAutoShutdown::FireDrainBatch);
+}
+
+// A session is drainable when nothing would be lost by closing it now:
+// parked at character select, or AFK out of combat. GM accounts are skipped
+static bool IsDrainableSession(WorldSession* session)
+{
+    if (session->GetSecurity() > SEC_PLAYER)
+        return false;
+
+    Player* player = session->GetPlayer();
+    if (!player)
+        return true;
+
+    return player->IsInWorld() && player->isAFK() && !player->IsInCombat();
+}
+
+/*static*/ void ServerAutoShutdown::FireDrainBatch(ServerAutoShutdown& self)
+{
+    auto const& config = self._armedConfig;
+
+    // Exhausted the previous pass: snapshot the current candidates. An empty
+    // snapshot means everything drainable is gone, stop the pipeline
+    if (self._drainCursor >= self._drainAccountIds.size())
+    {
+        self._drainAccountIds.clear();
+        self._drainCursor = 0;
+
+        for (auto const& [accountId, session] : sWorld->GetAllSessions())
+            if (IsDrainableSession(session))
+                self._drainAccountIds.emplace_back(accountId);
+
+        if (self._drainAccountIds.empty())
+        {
+            self._timers.Cancel(TIMER_DRAIN);
+            return;
+        }
+    }
+
+    uint32 kicked = 0;
+    while (self._drainCursor < self._drainAccountIds.size() && kicked < config->DrainBatchSize)
+    {
+        // Re-check at kick time: the session may have gone, come back from
+        // AFK or entered combat since the snapshot was taken
+        if (WorldSession* session = sWorld->FindSession(self._drainAccountIds[self._drainCursor]))
+            if (IsDrainableSession(session))
+            {
+                session->KickPlayer("ServerAutoShutdown idle session drain");
+                ++kicked;
+            }
+
+        ++self._drainCursor;
+    }
+}
+
+void ServerAutoShutdown::StartPreUnloadPipeline()
+{
+    if (_simActive)
+        return;
+
+    // One snapshot of every currently playerless map; candidates that gain
+    // players before their batch comes up are re-checked and skipped
+    _preUnloadMaps.clear();
+    _preUnloadCursor = 0;
+
+    sMapMgr->DoForAllMaps([this](Map* map)
+    {
+        if (!map->HavePlayers())
+            _preUnloadMaps.emplace_back(map->GetId(), map->GetInstanceId());
+    });
+
+    if (_preUnloadMaps.empty())
+        return;
+
+    LOG_INFO("module", "> ServerAutoShutdown: Starting map pre-unload ({} candidate(s), {} maps per {} ms)", _preUnloadMaps.size(), _armedConfig->PreUnloadBatchSize, _armedConfig->PreUnloadIntervalMs);
+
+    _preUnloadActive = true;
+    _timers.Arm(TIMER_PRE_UNLOAD, _armedConfig->PreUnloadIntervalMs, _armedConfig->PreUnloadIntervalMs, &ServerAutoShutdown::FirePreUnloadBatch);
+}
+
+/*static*/ void ServerAutoShutdown::FirePreUnloadBatch(ServerAutoShutdown& self)
+{
+    auto const& config = self._armedConfig;
+
+    // Single pass, unlike the flush pipeline: a grid unloaded once stays
+    // cheap at exit, and maps that empty later are still few enough there
+    if (self._preUnloadCursor >= self._preUnloadMaps.size())
+    {
+        self._timers.Cancel(TIMER_PRE_UNLOAD);
+        return;
+    }
+
+    uint32 unloaded = 0;
+    while (self._preUnloadCursor < self._preUnloadMaps.size() && unloaded < config->PreUnloadBatchSize)
+    {
+        auto const& [mapId, instanceId] = self._preUnloadMaps[self._preUnloadCursor];
+
+        // Re-resolve and re-check: the map may be gone already or a player
+        // may have entered since the snapshot was taken
+        if (Map* map = sMapMgr->FindMap(mapId, instanceId))
+            if (!map->HavePlayers())
+            {
+                map->UnloadAll();
+                ++unloaded;
+            }
+
+        ++self._preUnloadCursor;
+    }
+}
+
+void ServerAutoShutdown::StartMaintenancePipeline()
+{
+    if (_simActive)
+        return;
+
+    LOG_INFO("module", "> ServerAutoShutdown: Starting maintenance stage ({} task(s), deadline {} seconds before shutdown)", _armedConfig->MaintenanceTasks.size(), _armedConfig->MaintenanceDeadlineSeconds);
+
+    _maintenanceActive = true;
+    _maintenanceCursor = 0;
+    _maintenanceTaskRunning = false;
+    _maintenanceDeadline = _armedShutdownTime - static_cast<time_t>(_armedConfig->MaintenanceDeadlineSeconds);
+    ++_maintenanceGeneration;
+    _timers.Arm(TIMER_MAINTENANCE, IN_MILLISECONDS, IN_MILLISECONDS, &ServerAutoShutdown::FireMaintenanceStep);
+}
+
+/*static*/ void ServerAutoShutdown::FireMaintenanceStep(ServerAutoShutdown& self)
+{
+    auto const& config = self._armedConfig;
+
+    // Completions come back here, on the world thread - the task itself ran
+    // on the DB worker, the tick only pays the bookkeeping
+    self._maintenanceQueries.ProcessReadyCallbacks();
+
+    // One task in flight at a time: maintenance I/O should trickle through
+    // the quiet window, not stack up on the DB worker
+    if (self._maintenanceTaskRunning)
+        return;
+
+    if (self._maintenanceCursor >= config->MaintenanceTasks.size())
+    {
+        LOG_INFO("module", "> ServerAutoShutdown: Maintenance stage finished, all {} task(s) done", config->MaintenanceTasks.size());
+        self._timers.Cancel(TIMER_MAINTENANCE);
+        return;
+    }
+
+    // Hard deadline: never start a task the shutdown could collide with
+    if (self.WallNow() >= self._maintenanceDeadline)
+    {
+        LOG_WARN("module", "> ServerAutoShutdown: Maintenance deadline reached, skipping {} remaining task(s)", config->MaintenanceTasks.size() - self._maintenanceCursor);
+        self._timers.Cancel(TIMER_MAINTENANCE);
+        return;
+    }
+
+    std::string const& task = config->MaintenanceTasks[self._maintenanceCursor];
+    LOG_INFO("module", "> ServerAutoShutdown: Maintenance task {}/{}: {}", self._maintenanceCursor + 1, config->MaintenanceTasks.size(), task);
+
+    self._maintenanceTaskRunning = true;
+    self._maintenanceTaskStart = std::chrono::steady_clock::now();
+
+    uint32 generation = self._maintenanceGeneration;
+    self._maintenanceQueries.AddCallback(CharacterDatabase.AsyncQuery(task.c_str()).WithCallback([&self, generation](QueryResult /*result*/)
+    {
+        // A reload reset the pipeline while this task ran; drop the completion
+        if (generation != self._maintenanceGeneration)
+            return;
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - self._maintenanceTaskStart);
+        LOG_INFO("module", "> ServerAutoShutdown: Maintenance task {} finished after {} ms", self._maintenanceCursor + 1, elapsed.count());
+
+        self._maintenanceTaskRunning = false;
+        ++self._maintenanceCursor;
+    }));
+}
+
+void ServerAutoShutdown::ArmLadderRung(std::size_t rungIndex)
+{
+    time_t nowTime = WallNow();
+
+    // Skip rungs that already lie in the past
+    while (rungIndex < _armedConfig->LadderMessages.size() && _armedShutdownTime - static_cast<time_t>(_armedConfig->LadderMessages[rungIndex].SecondsBefore) <= nowTime)
+        ++rungIndex;
+
+    if (rungIndex >= _armedConfig->LadderMessages.size())
+    {
+        // Every rung lies in the past: the occurrence is closer than the
+        // smallest rung, or a clock step swallowed the rest of the ladder.
+        // Fall back to the single pre-announce so the occurrence still
+        // announces and hands its countdown to World, instead of being
+        // silently dropped with nothing armed
+        _timers.ArmAt(TIMER_PRE_ANNOUNCE, nowTime + 1, nowTime, 0, &ServerAutoShutdown::FirePreAnnounce);
+        return;
+    }
+
+    _ladderIndex = rungIndex;
+    _timers.ArmAt(TIMER_LADDER, _armedShutdownTime - static_cast<time_t>(_armedConfig->LadderMessages[rungIndex].SecondsBefore), nowTime, 0, &ServerAutoShutdown::FireLadderRung);
+}
+
+/*static*/ void ServerAutoShutdown::FireLadderRung(ServerAutoShutdown& self)
+{
+    auto const& config = self._armedConfig;
+    auto const& rung = config->LadderMessages[self._ladderIndex];
+
+    // One session counter read per rung; the thinning policy itself was
+    // precomputed into SessionCap at parse time
+    uint32 sessions = self._simActive ? 0 : sWorld->GetActiveSessionCount();
+
+    // First fired rung opens the announce window, sample the telemetry there
+    if (!self._simActive && !self._telemetrySessionsAtPreAnnounce)
+        self._telemetrySessionsAtPreAnnounce = sessions;
+
+    // ... and persist the crash-resume marker for the rest of the window
+    if (!self._simActive && !self._midCountdown)
+    {
+        self._midCountdown = true;
+        self.SaveStateFile();
+    }
+
+    if (sessions <= rung.SessionCap)
+    {
+        LOG_INFO("module", "> {}", rung.Messages[DEFAULT_LOCALE]);
+        self.BroadcastAnnounce(config, rung.Messages);
+        self.BroadcastAddonCountdown(rung.SecondsBefore);
+    }
+    else
+        LOG_INFO("module", "> ServerAutoShutdown: Skipping the {} seconds announce rung, {} sessions online (full density up to {})",
+            rung.SecondsBefore, sessions, config->LadderFullDensitySessions);
+
+    // First rung that fires opens the announce window, start the pipelines
+    if (config->PreFlushEnabled && !self._preFlushActive)
+        self.StartPreFlushPipeline();
+
+    if (config->DrainEnabled && !self._drainActive)
+        self.StartDrainPipeline();
+
+    if (config->MaintenanceEnabled && !self._maintenanceActive)
+        self.StartMaintenancePipeline();
+
+    if (config->PreUnloadEnabled && !self._preUnloadActive)
+        self.StartPreUnloadPipeline();
+
+    if (self._ladderIndex + 1 >= config->LadderMessages.size())
+    {
+        // Last rung: hand the remaining countdown to World unless the
+        // low-population window gate owns the actual shutdown
+        if (!config->WindowEnabled)
+            self.RequestShutdown(rung.SecondsBefore);
+    }
+    else
+        self.ArmLadderRung(self._ladderIndex + 1);
+}
+
+ServerAutoShutdown::~ServerAutoShutdown()
+{
+    StopTimerThread();
+    StopWebhookThread();
+    StopConfigWatchThread();
+}
+
+void ServerAutoShutdown::DoPreAnnounce(std::shared_ptr<ServerAutoShutdownConfig const> const& config)
+{
+    // Telemetry: how many sessions the announce window started with
+    if (!_simActive)
+        _telemetrySessionsAtPreAnnounce = sWorld->GetActiveSessionCount();
+
+    // Persist that the window opened: from here on a crash resumes this
+    // countdown on the next boot instead of rescheduling it
+    if (!_simActive && !_midCountdown)
+    {
+        _midCountdown = true;
+        SaveStateFile();
+    }
+
+    NotifyLifecycleEvent(WEBHOOK_PRE_ANNOUNCE);
+
+    // All messages were formatted at Init(), nothing to build at fire time
+    LOG_INFO("module", "> {}", _armedPreAnnounceMessages[DEFAULT_LOCALE]);
+    BroadcastAnnounce(config, _armedPreAnnounceMessages);
+    BroadcastAddonCountdown(_armedPreAnnounceSeconds);
+
+    // The announce window has begun: start amortizing the final save cost
+    if (config->PreFlushEnabled && !_preFlushActive)
+        StartPreFlushPipeline();
+
+    // ... and the final teardown cost, by thinning out idle sessions early
+    if (config->DrainEnabled && !_drainActive)
+        StartDrainPipeline();
+
+    // The character DB is about to go quiet: run the maintenance tasks now
+    if (config->MaintenanceEnabled && !_maintenanceActive)
+        StartMaintenancePipeline();
+
+    // ... and drop the playerless map grids the exit would otherwise unload
+    if (config->PreUnloadEnabled && !_preUnloadActive)
+        StartPreUnloadPipeline();
+
+    // With the low-population window the gate task owns the ShutdownServ call
+    if (!config->WindowEnabled)
+        RequestShutdown(_armedPreAnnounceSeconds);
+}
+
+void ServerAutoShutdown::BroadcastAnnounce(std::shared_ptr<ServerAutoShutdownConfig const> const& config, ServerAutoShutdownConfig::AnnounceMessages const& messages)
+{
+    if (_simActive)
+    {
+        SimRecord(Acore::StringFormat("announce: {}", messages[DEFAULT_LOCALE]));
+        return;
+    }
+
+    // No localized templates: one global broadcast, as before
+    if (!config->HasLocalizedMessages)
+    {
+        sWorld->SendServerMessage(SERVER_MSG_STRING, messages[DEFAULT_LOCALE]);
+        return;
+    }
+
+    // Hand every session the prebuilt string for its locale by reference -
+    // O(locales) formatting happened at init, this loop only enqueues
+    for (auto const& [accountId, session] : sWorld->GetAllSessions())
+    {
+        Player* player = session->GetPlayer();
+        if (!player || !player->IsInWorld())
+            continue;
+
+        LocaleConstant locale = session->GetSessionDbLocaleIndex();
+        std::string const& message = (locale < TOTAL_LOCALES && !messages[locale].empty()) ? messages[locale] : messages[DEFAULT_LOCALE];
+        sWorld->SendServerMessage(SERVER_MSG_STRING, message, player);
+    }
+}
+
+void ServerAutoShutdown::BuildAddonPackets(std::shared_ptr<ServerAutoShutdownConfig const> const& config)
+{
+    _addonPackets.clear();
+
+    if (!config->AddonEnabled || _simActive)
+        return;
+
+    // Every distinct remaining-seconds value the countdown can emit
+    std::vector<uint32> rungSeconds;
+    rungSeconds.emplace_back(_armedPreAnnounceSeconds);
+    for (auto const& rung : config->LadderMessages)
+        rungSeconds.emplace_back(rung.SecondsBefore);
+
+    std::sort(rungSeconds.begin(), rungSeconds.end());
+    rungSeconds.erase(std::unique(rungSeconds.begin(), rungSeconds.end()), rungSeconds.end());
+
+    // The chat payload is a C string on the wire, so the remaining seconds
+    // ride as one compact decimal token after the registered prefix - no
+    // display formatting, the addon parses two fields
+    _addonPackets.reserve(rungSeconds.size());
+    for (uint32 seconds : rungSeconds)
+    {
+        WorldPacket data;
+        ChatHandler::BuildChatPacket(data, CHAT_MSG_WHISPER, LANG_ADDON, ObjectGuid::Empty, ObjectGuid::Empty,
+            Acore::StringFormat("{}\t{}", config->AddonPrefix, seconds), 0);
+        _addonPackets.emplace_back(seconds, std::move(data));
+    }
+}
+
+void ServerAutoShutdown::BroadcastAddonCountdown(uint32 secondsRemaining)
+{
+    if (_addonPackets.empty())
+        return;
+
+    // A handful of rungs at most, the linear scan is the fast option
+    WorldPacket const* packet = nullptr;
+    for (auto const& [seconds, data] : _addonPackets)
+        if (seconds == secondsRemaining)
+        {
+            packet = &data;
+            break;
+        }
+
+    if (!packet)
+        return;
+
+    // The same immutable buffer is handed to every session; SendPacket only
+    // appends it to the per-session send queue, nothing is copied per rung
+    for (auto const& [accountId, session] : sWorld->GetAllSessions())
+        if (Player* player = session->GetPlayer())
+            if (player->IsInWorld())
+                session->SendPacket(packet);
+}
+
+time_t ServerAutoShutdown::WallNow() const
+{
+    if (_simActive)
+        return _simNow;
+
+    auto elapsed = std::chrono::steady_clock::now() - _lastResyncSteady;
+    return _lastResyncWall + static_cast<time_t>(std::chrono::duration_cast<std::chrono::seconds>(elapsed).count());
+}
+
+/*static*/ void ServerAutoShutdown::FireClockResync(ServerAutoShutdown& self)
+{
+    // Under the virtual clock there is nothing to drift against
+    if (self._simActive)
+    {
+        self._timers.Resync(self._simNow);
+        return;
+    }
+
+    // The only time() read after startup: compare how far both clocks moved
+    // since the last anchor - any difference is an NTP step or DST transition
+    time_t wallNow = time(nullptr);
+    auto steadyNow = std::chrono::steady_clock::now();
+
+    int64 steadyElapsed = std::chrono::duration_cast<std::chrono::seconds>(steadyNow - self._lastResyncSteady).count();
+    int64 drift = static_cast<int64>(wallNow - self._lastResyncWall) - steadyElapsed;
+
+    if (drift > 5 || drift < -5)
+        LOG_WARN("module", "> ServerAutoShutdown: Wall clock stepped by {} seconds since the last resync, re-anchoring shutdown timers", drift);
+
+    self._lastResyncWall = wallNow;
+    self._lastResyncSteady = steadyNow;
+    self._timers.Resync(wallNow);
+}
+
+void ServerAutoShutdown::SimRecord(std::string what)
+{
+    _simEvents.emplace_back(_simNow, std::move(what));
+}
+
+void ServerAutoShutdown::SimShutdown(uint32 delaySeconds)
+{
+    SimRecord(Acore::StringFormat("ShutdownServ(restart) with {} seconds countdown", delaySeconds));
+
+    // The virtual worldserver comes back up shortly after the countdown ends
+    _simRestartAt = _simNow + static_cast<time_t>(delaySeconds) + 30;
+}
+
+void ServerAutoShutdown::RunScheduleSimulation(uint32 days)
+{
+    LOG_INFO("module", "> ServerAutoShutdown: Simulating {} day(s) of schedule against a virtual clock", days);
+
+    _simActive = true;
+    _simNow = time(nullptr);
+    _simRestartAt = 0;
+    _simEvents.clear();
+
+    time_t simEnd = _simNow + static_cast<time_t>(days) * DAY;
+
+    Init();
+    if (!_isEnableModule)
+    {
+        LOG_WARN("module", "> ServerAutoShutdown: Simulation aborted, module not enabled or config invalid");
+        _simActive = false;
+        return;
+    }
+
+    while (_simNow < simEnd)
+    {
+        // A recorded shutdown ends this virtual uptime: jump past the restart
+        // and re-run Init() like the fresh worldserver would
+        if (_simRestartAt)
+        {
+            _simNow = _simRestartAt;
+            _simRestartAt = 0;
+            SimRecord("worldserver restarted");
+            Init();
+            continue;
+        }
+
+        // Jump straight to the next wheel deadline instead of replaying every
+        // 50 ms world tick; the wheel sees it as one large OnUpdate diff
+        uint64 stepMs = _timers.MsToNextFire(uint64(simEnd - _simNow) * IN_MILLISECONDS);
+        uint64 stepSeconds = std::max<uint64>(1, (stepMs + IN_MILLISECONDS - 1) / IN_MILLISECONDS);
+
+        _simNow += static_cast<time_t>(stepSeconds);
+        _timers.Update(*this, static_cast<uint32>(std::min<uint64>(stepSeconds * IN_MILLISECONDS, 0xFFFFFFFF)));
+    }
+
+    LOG_INFO("module", "> ServerAutoShutdown: Simulation produced {} event(s):", _simEvents.size());
+    for (auto const& [when, what] : _simEvents)
+        LOG_INFO("module", "> ServerAutoShutdown: [{}] {}", Acore::Time::TimeToHumanReadable(Seconds(when)), what);
+
+    // Leave no armed state behind; the real Init() follows right after
+    _timers.CancelAll();
+    _simEvents.clear();
+    _simActive = false;
+}
+
+namespace
+{
+    char const* WebhookEventName(uint8 type)
+    {
+        switch (type)
+        {
+            case WEBHOOK_SCHEDULE_ARMED: return "schedule_armed";
+            case WEBHOOK_PRE_ANNOUNCE:   return "pre_announce";
+            case WEBHOOK_SHUTDOWN_FIRED: return "shutdown_fired";
+            case WEBHOOK_BACK_ONLINE:    return "back_online";
+            default:                     return "unknown";
+        }
+    }
+
+    // One fire-and-forget HTTP POST, fully asynchronous against a private
+    // io_context bounded by run_for - a dead endpoint costs the worker the
+    // timeout, never more, and the world thread nothing at all
+    void PostWebhookEvent(std::shared_ptr<ServerAutoShutdownConfig const> const& config, uint8 type, int64 when, int64 shutdownTime, uint32 sessions)
+    {
+        std::string body = Acore::StringFormat(R"({{"event":"{}","realm":{},"time":{},"shutdown_time":{},"sessions":{}}})",
+            WebhookEventName(type), realm.Id.Realm, when, shutdownTime, sessions);
+
+        std::string request = Acore::StringFormat(
+            "POST {} HTTP/1.1\r\nHost: {}\r\nContent-Type: application/json\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}",
+            config->WebhookTarget, config->WebhookHost, body.size(), body);
+
+        try
+        {
+            boost::asio::io_context io;
+            boost::asio::ip::tcp::resolver resolver(io);
+            boost::asio::ip::tcp::socket socket(io);
+            bool written = false;
+
+            resolver.async_resolve(config->WebhookHost, config->WebhookPort,
+                [&](boost::system::error_code ec, boost::asio::ip::tcp::resolver::results_type results)
+            {
+                if (ec)
+                    return;
+
+                boost::asio::async_connect(socket, results,
+                    [&](boost::system::error_code ec, boost::asio::ip::tcp::endpoint const&)
+                {
+                    if (ec)
+                        return;
+
+                    boost::asio::async_write(socket, boost::asio::buffer(request),
+                        [&](boost::system::error_code ec, std::size_t)
+                    {
+                        written = !ec;
+                    });
+                });
+            });
+
+            io.run_for(std::chrono::milliseconds(config->WebhookTimeoutMs));
+
+            if (!written)
+                LOG_WARN("module", "> ServerAutoShutdown: Webhook event '{}' not delivered to {} within {} ms", WebhookEventName(type), config->WebhookUrl, config->WebhookTimeoutMs);
+        }
+        catch (std::exception const& e)
+        {
+            LOG_WARN("module", "> ServerAutoShutdown: Webhook event '{}' failed: {}", WebhookEventName(type), e.what());
+        }
+    }
+}
+
+void ServerAutoShutdown::NotifyLifecycleEvent(ShutdownWebhookEvent type)
+{
+    if (_simActive)
+        return;
+
+    auto config = GetConfig();
+    if (!config || !config->WebhookEnabled)
+        return;
+
+    StartWebhookThread();
+
+    // Single producer (world thread): a full ring drops the event, the tick
+    // never waits on the network or the worker
+    uint32 tail = _webhookTail.load(std::memory_order_relaxed);
+    uint32 next = (tail + 1) % WEBHOOK_QUEUE_SIZE;
+
+    if (next == _webhookHead.load(std::memory_order_acquire))
+    {
+        LOG_WARN("module", "> ServerAutoShutdown: Webhook queue full, dropping event '{}'", WebhookEventName(type));
+        return;
+    }
+
+    WebhookEventData& event = _webhookQueue[tail];
+    event.Type = type;
+    event.When = static_cast<int64>(time(nullptr));
+    event.ShutdownTime = static_cast<int64>(_armedShutdownTime);
+    event.Sessions = sWorld->GetActiveSessionCount();
+
+    _webhookTail.store(next, std::memory_order_release);
+    _webhookCondVar.notify_one();
+}
+
+void ServerAutoShutdown::StartWebhookThread()
+{
+    if (_webhookThread.joinable())
+        return;
+
+    _webhookStop.store(false, std::memory_order_relaxed);
+    _webhookThread = std::thread(&ServerAutoShutdown::WebhookThreadMain, this);
+}
+
+void ServerAutoShutdown::StopWebhookThread()
+{
+    if (!_webhookThread.joinable())
+        return;
+
+    _webhookStop.store(true, std::memory_order_release);
+    _webhookCondVar.notify_one();
+    _webhookThread.join();
+}
+
+void ServerAutoShutdown::WebhookThreadMain()
+{
+    std::unique_lock<std::mutex> lock(_webhookMutex);
+
+    while (!_webhookStop.load(std::memory_order_acquire))
+    {
+        // The timeout covers the unlocked notify window; the queue indices
+        // are the ground truth, the condvar is only a wakeup hint
+        _webhookCondVar.wait_for(lock, std::chrono::milliseconds(500));
+
+        uint32 head = _webhookHead.load(std::memory_order_relaxed);
+        while (head != _webhookTail.load(std::memory_order_acquire))
+        {
+            WebhookEventData event = _webhookQueue[head];
+            head = (head + 1) % WEBHOOK_QUEUE_SIZE;
+            _webhookHead.store(head, std::memory_order_release);
+
+            if (auto config = GetConfig(); config && config->WebhookEnabled)
+            {
+                // Post without the lock so the producer never contends
+                lock.unlock();
+                PostWebhookEvent(config, event.Type, event.When, event.ShutdownTime, event.Sessions);
+                lock.lock();
+            }
+        }
+    }
+}
+
+void ServerAutoShutdown::StartConfigWatchThread(std::string path)
+{
+    if (_configWatchThread.joinable())
+        return;
+
+    _configWatchPath = std::move(path);
+    _configWatchStop.store(false, std::memory_order_relaxed);
+    _configWatchThread = std::thread(&ServerAutoShutdown::ConfigWatchThreadMain, this);
+}
+
+void ServerAutoShutdown::StopConfigWatchThread()
+{
+    if (!_configWatchThread.joinable())
+        return;
+
+    // The watcher polls with a bounded timeout, so the join is bounded too
+    _configWatchStop.store(true, std::memory_order_release);
+    _configWatchThread.join();
+}
+
+void ServerAutoShutdown::ConfigWatchThreadMain()
+{
+#ifdef __linux__
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0)
+    {
+        LOG_ERROR("module", "> ServerAutoShutdown: inotify_init1 failed (errno {}), config hot watch disabled", errno);
+        return;
+    }
+
+    // Watch the directory, not the file: editors and deployment tools replace
+    // the file by renaming a temp copy over it, which orphans a file watch
+    std::string directory = ".";
+    std::string fileName = _configWatchPath;
+    if (std::size_t slash = _configWatchPath.find_last_of('/'); slash != std::string::npos)
+    {
+        directory = _configWatchPath.substr(0, slash);
+        fileName = _configWatchPath.substr(slash + 1);
+    }
+
+    if (inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0)
+    {
+        LOG_ERROR("module", "> ServerAutoShutdown: Can't watch '{}' (errno {}), config hot watch disabled", directory, errno);
+        close(inotifyFd);
+        return;
+    }
+
+    LOG_INFO("module", "> ServerAutoShutdown: Watching '{}' for schedule edits", _configWatchPath);
+
+    bool dirty = false;
+    while (!_configWatchStop.load(std::memory_order_acquire))
+    {
+        // The poll timeout doubles as the debounce window: a burst of events
+        // from one save collapses into a single rebuild on the quiet edge
+        pollfd pollFd = { inotifyFd, POLLIN, 0 };
+        int ready = poll(&pollFd, 1, 500);
+
+        if (ready > 0)
+        {
+            alignas(inotify_event) char eventBuffer[4096];
+            ssize_t bytes;
+            while ((bytes = read(inotifyFd, eventBuffer, sizeof(eventBuffer))) > 0)
+            {
+                for (ssize_t offset = 0; offset < bytes;)
+                {
+                    auto const* event = reinterpret_cast<inotify_event const*>(eventBuffer + offset);
+                    if (event->len && fileName == event->name)
+                        dirty = true;
+
+                    offset += sizeof(inotify_event) + event->len;
+                }
+            }
+
+            continue;
+        }
+
+        if (ready || !dirty)
+            continue;
+
+        dirty = false;
+        LOG_INFO("module", "> ServerAutoShutdown: '{}' changed, re-arming schedule from the edited config", _configWatchPath);
+
+        // The shared option cache must not be rewritten from here while
+        // world-thread readers sit inside GetOption: hand the reload to
+        // ProcessPendingInit, which refreshes the cache on the world thread
+        // and then runs the normal off-thread parse/build
+        _pendingConfigReload.store(true, std::memory_order_release);
+    }
+
+    close(inotifyFd);
+#endif
+}
+
+void ServerAutoShutdown::ProcessTimerThreadFire()
+{
+    if (!_pendingTimerFire.load(std::memory_order_acquire))
+        return;
+
+    _pendingTimerFire.store(false, std::memory_order_relaxed);
+
+    // A disabling reload can land between the thread tripping the deadline
+    // and this drain - a stale fire must not start the countdown
+    if (!_isEnableModule)
+        return;
+
+    if (auto config = GetConfig(); config && config->Enabled)
+        DoPreAnnounce(config);
+}
+
+void ServerAutoShutdown::ArmTimerThread(time_t fireTime)
+{
+    {
+        std::lock_guard<std::mutex> lock(_timerMutex);
+        _timerDeadline = fireTime;
+        ++_timerGeneration;
+        _pendingTimerFire.store(false, std::memory_order_relaxed);
+
+        if (!_timerThread.joinable())
+            _timerThread = std::thread(&ServerAutoShutdown::TimerThreadMain, this);
+    }
+
+    _timerCondVar.notify_one();
+}
+
+void ServerAutoShutdown::StopTimerThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(_timerMutex);
+        if (!_timerThread.joinable())
+            return;
+
+        _timerThreadStop = true;
+    }
+
+    _timerCondVar.notify_one();
+    _timerThread.join();
+}
+
+void ServerAutoShutdown::TimerThreadMain()
+{
+    std::unique_lock<std::mutex> lock(_timerMutex);
+
+    for (;;)
+    {
+        _timerCondVar.wait(lock, [this] { return _timerThreadStop || _timerDeadline; });
+        if (_timerThreadStop)
+            return;
+
+        // Wait out the armed deadline, waking early if Init() re-arms it
+        uint32 generation = _timerGeneration;
+        while (!_timerThreadStop && _timerGeneration == generation)
+        {
+            time_t remaining = _timerDeadline - time(nullptr);
+            if (remaining <= 0)
+            {
+                _timerDeadline = 0;
+                _pendingTimerFire.store(true, std::memory_order_release);
+                break;
+            }
+
+            // Cap the sleep: wait_for runs on the steady clock, so without a
+            // periodic wall re-read a forward NTP step would fire us late
+            _timerCondVar.wait_for(lock, Seconds(std::min<time_t>(remaining, MINUTE)));
+        }
+
+        if (_timerThreadStop)
+            return;
+    }
+}
+
+void ServerAutoShutdown::OnUpdate(uint32 diff)
+{
+    // Counters off (the default): no clock reads, straight to the real body
+    if (!_perfEnabled)
+    {
+        UpdateCore(diff);
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    UpdateCore(diff);
+    RecordUpdateDuration(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void ServerAutoShutdown::UpdateCore(uint32 diff)
+{
+    // Apply a finished async reload first; it may enable or disable the module
+    ProcessPendingInit();
+
+    // If module disable, why do the update? hah
+    if (!_isEnableModule)
+        return;
+
+    // Fast path: one add and one compare per tick until a deadline is near.
+    // The skipped time is fed to the wheel in one batch when the gate opens
+    _msSinceLastUpdate += diff;
+    if (_msSinceLastUpdate + SCHEDULER_WAKEUP_WINDOW_MS < _msToNextTask)
+        return;
+
+    _timers.Update(*this, _msSinceLastUpdate);
+    _msSinceLastUpdate = 0;
+
+    if (_perfEnabled)
+    {
+        _perfWheelWakeups.fetch_add(1, std::memory_order_relaxed);
+        _perfLastDriftMs.store(_timers.LastFireOvershootMs(), std::memory_order_relaxed);
+        _perfMaxDriftMs.store(_timers.MaxFireOvershootMs(), std::memory_order_relaxed);
+    }
+
+    // The wheel knows its exact next deadline, re-arm the gate from it
+    _msToNextTask = static_cast<uint32>(_timers.MsToNextFire(IDLE_GATE_MS));
+}
+
+void ServerAutoShutdown::RecordUpdateDuration(uint64 ns)
+{
+    _perfUpdateCalls.fetch_add(1, std::memory_order_relaxed);
+    _perfUpdateTotalNs.fetch_add(ns, std::memory_order_relaxed);
+
+    if (ns < _perfUpdateMinNs.load(std::memory_order_relaxed))
+        _perfUpdateMinNs.store(ns, std::memory_order_relaxed);
+
+    // log2 bucket index; the loop runs at most 31 times and typically ~8
+    std::size_t bucket = 0;
+    for (uint64 value = ns; value > 1 && bucket < PERF_HISTOGRAM_BUCKETS - 1; value >>= 1)
+        ++bucket;
+
+    _perfHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+ServerAutoShutdownPerfStats ServerAutoShutdown::GetPerfStats() const
+{
+    ServerAutoShutdownPerfStats stats;
+    stats.UpdateCalls = _perfUpdateCalls.load(std::memory_order_relaxed);
+    stats.WheelWakeups = _perfWheelWakeups.load(std::memory_order_relaxed);
+    stats.LastFireDriftMs = _perfLastDriftMs.load(std::memory_order_relaxed);
+    stats.MaxFireDriftMs = _perfMaxDriftMs.load(std::memory_order_relaxed);
+    stats.LastInitNs = _perfLastInitNs.load(std::memory_order_relaxed);
+
+    if (!stats.UpdateCalls)
+        return stats;
+
+    uint64 minNs = _perfUpdateMinNs.load(std::memory_order_relaxed);
+    stats.UpdateMinNs = minNs == UINT64_MAX ? 0 : minNs;
+    stats.UpdateAvgNs = _perfUpdateTotalNs.load(std::memory_order_relaxed) / stats.UpdateCalls;
+
+    // Walk the histogram until 99% of the samples are covered; report the
+    // upper bound of that bucket
+    uint64 threshold = stats.UpdateCalls - stats.UpdateCalls / 100;
+    uint64 covered = 0;
+    for (std::size_t bucket = 0; bucket < PERF_HISTOGRAM_BUCKETS; ++bucket)
+    {
+        covered += _perfHistogram[bucket].load(std::memory_order_relaxed);
+        if (covered >= threshold)
+        {
+            stats.UpdateP99Ns = uint64(1) << (bucket + 1);
+            break;
+        }
+    }
+
+    return stats;
+}
+
+void ServerAutoShutdown::ArmSchedulerGate(uint32 msToNextTask)
+{
+    _msToNextTask = msToNextTask;
+    _msSinceLastUpdate = 0;
+}
+
+void ServerAutoShutdown::BuildPersistentEventCache(std::shared_ptr<ServerAutoShutdownConfig const> const& config)
+{
+    _persistentEvents.clear();
+
+    GameEventMgr::GameEventDataMap const& events = sGameEventMgr->GetEventMap();
+
+    for (auto token : Acore::Tokenize(config->StartEvents, ' ', false))
+    {
+        if (token.empty())
+        {
+            continue;
+        }
+
+        auto eventId = Acore::StringTo<uint32>(token);
+        if (!eventId)
+        {
+            LOG_ERROR("module", "> ServerAutoShutdown: Incorrect event in config option 'ServerAutoShutdown.StartEvents' - '{}'", token);
+            continue;
+        }
+
+        if (*eventId >= events.size())
+        {
+            LOG_ERROR("module", "> ServerAutoShutdown: Unknown event in config option 'ServerAutoShutdown.StartEvents' - '{}'", *eventId);
+            continue;
+        }
+
+        _persistentEvents.emplace_back(*eventId);
+    }
+
+    std::sort(_persistentEvents.begin(), _persistentEvents.end());
+    _persistentEvents.erase(std::unique(_persistentEvents.begin(), _persistentEvents.end()), _persistentEvents.end());
+}
+
+bool ServerAutoShutdown::IsManagedEvent(uint32 eventId) const
+{
+    return std::binary_search(_persistentEvents.begin(), _persistentEvents.end(), eventId);
+}
+
+void ServerAutoShutdown::StartPersistentGameEvents()
+{
+    if (_persistentEvents.empty())
+        return;
+
+    // Timer thread mode never ticks the wheel, start synchronously as before
+    if (_armedConfig && _armedConfig->UseTimerThread)
+    {
+        GameEventMgr::GameEventDataMap const& events = sGameEventMgr->GetEventMap();
+        for (uint32 eventId : _persistentEvents)
+        {
+            sGameEventMgr->StartEvent(eventId);
+            LOG_INFO("module", "> ServerAutoShutdown: Starting event {} ({}).", events[eventId].description, eventId);
+        }
+
+        return;
+    }
+
+    // StartEvent spawns every creature and gameobject of the event; doing
+    // five of those back-to-back during OnStartup delays "accepting
+    // connections" noticeably. Queue them on the wheel instead: one event
+    // per fire, spread over the first seconds of uptime
+    _eventStartCursor = 0;
+    _timers.Arm(TIMER_EVENT_START, EVENT_START_SPACING_MS, EVENT_START_SPACING_MS, &ServerAutoShutdown::FireEventStart);
+    ArmSchedulerGate(static_cast<uint32>(_timers.MsToNextFire(IDLE_GATE_MS)));
+}
+
+/*static*/ void ServerAutoShutdown::FireEventStart(ServerAutoShutdown& self)
+{
+    GameEventMgr::GameEventDataMap const& events = sGameEventMgr->GetEventMap();
+
+    uint32 eventId = self._persistentEvents[self._eventStartCursor];
+    sGameEventMgr->StartEvent(eventId);
+
+    GameEventData const& eventData = events[eventId];
+    LOG_INFO("module", "> ServerAutoShutdown: Starting event {} ({}).", eventData.description, eventId);
+
+    if (++self._eventStartCursor >= self._persistentEvents.size())
+        self._timers.Cancel(TIMER_EVENT_START);
 }
@@ -19,6 +19,356 @@
 #define _SERVER_AUTO_SHUTDOWN_H_
 
 #include "Common.h"
+#include "ObjectGuid.h"
+#include "QueryCallback.h"
+#include "WorldPacket.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ServerAutoShutdown;
+
+// Every timer this module can ever hold - the kinds are known at compile time
+enum ShutdownTimerKind : uint8
+{
+    TIMER_PRE_ANNOUNCE = 0,
+    TIMER_LADDER,
+    TIMER_WINDOW_GATE,
+    TIMER_PRE_FLUSH,
+    TIMER_DRAIN,
+    TIMER_CLOCK_RESYNC,
+    TIMER_EVENT_START,
+    TIMER_VETO_RETRY,
+    TIMER_ADAPTIVE,
+    TIMER_MAINTENANCE,
+    TIMER_PRE_UNLOAD,
+
+    MAX_SHUTDOWN_TIMERS
+};
+
+// Fixed-capacity timer wheel specialized for this module: a static array of
+// slots in function-pointer-plus-context layout. No std::function, no heap
+// allocation, no ordered container - the whole structure stays resident in a
+// cache line or two and advancing it is a short predictable loop
+class ShutdownTimerWheel
+{
+public:
+    using Callback = void (*)(ServerAutoShutdown&);
+
+    void Arm(ShutdownTimerKind kind, uint64 delayMs, uint64 intervalMs, Callback callback)
+    {
+        _slots[kind] = { delayMs, intervalMs, callback, true, 0 };
+    }
+
+    // Arm against an absolute wall-clock deadline. The slot still counts down
+    // in elapsed (monotonic) milliseconds, but Resync() can re-anchor it when
+    // the wall clock steps, so the real fire time tracks the target
+    void ArmAt(ShutdownTimerKind kind, time_t deadline, time_t now, uint64 intervalMs, Callback callback)
+    {
+        uint64 delayMs = deadline > now ? uint64(deadline - now) * 1000 : 0;
+        _slots[kind] = { delayMs, intervalMs, callback, true, deadline };
+    }
+
+    void Cancel(ShutdownTimerKind kind) { _slots[kind].Active = false; }
+
+    void CancelAll()
+    {
+        for (Slot& slot : _slots)
+            slot.Active = false;
+    }
+
+    // How far past its deadline the most recent fire ran: the batched diff
+    // minus what the slot had left. Feeds the module's perf counters
+    uint64 LastFireOvershootMs() const { return _lastFireOvershootMs; }
+    uint64 MaxFireOvershootMs() const { return _maxFireOvershootMs; }
+
+    // Smallest remaining delay over all active slots, defaultMs when idle
+    uint64 MsToNextFire(uint64 defaultMs) const
+    {
+        uint64 next = defaultMs;
+        for (Slot const& slot : _slots)
+            if (slot.Active && slot.RemainingMs < next)
+                next = slot.RemainingMs;
+
+        return next;
+    }
+
+    // Re-derive the remaining time of every absolute slot from the wall
+    // clock, correcting for any NTP step or DST transition since arming
+    void Resync(time_t now)
+    {
+        for (Slot& slot : _slots)
+            if (slot.Active && slot.DeadlineEpoch)
+                slot.RemainingMs = slot.DeadlineEpoch > now ? uint64(slot.DeadlineEpoch - now) * 1000 : 0;
+    }
+
+    void Update(ServerAutoShutdown& owner, uint32 diffMs)
+    {
+        for (Slot& slot : _slots)
+        {
+            if (!slot.Active)
+                continue;
+
+            if (slot.RemainingMs > diffMs)
+            {
+                slot.RemainingMs -= diffMs;
+                continue;
+            }
+
+            _lastFireOvershootMs = diffMs - slot.RemainingMs;
+            if (_lastFireOvershootMs > _maxFireOvershootMs)
+                _maxFireOvershootMs = _lastFireOvershootMs;
+
+            // Re-arm repeating slots before the callback so it may cancel
+            // itself; repeats after an absolute first fire are relative
+            if (slot.IntervalMs)
+            {
+                slot.RemainingMs = slot.IntervalMs;
+                slot.DeadlineEpoch = 0;
+            }
+            else
+                slot.Active = false;
+
+            slot.Fire(owner);
+        }
+    }
+
+private:
+    struct Slot
+    {
+        uint64 RemainingMs = 0;
+        uint64 IntervalMs = 0;
+        Callback Fire = nullptr;
+        bool Active = false;
+        time_t DeadlineEpoch = 0; // 0 = purely relative slot
+    };
+
+    std::array<Slot, MAX_SHUTDOWN_TIMERS> _slots = {};
+    uint64 _lastFireOvershootMs = 0;
+    uint64 _maxFireOvershootMs = 0;
+};
+
+// One cron-like schedule entry: a weekday mask plus a time of day.
+// Sunday is bit 0, matching tm_wday
+struct ShutdownScheduleEntry
+{
+    uint8 DayMask = 0;
+    uint8 Hour = 0;
+    uint8 Minute = 0;
+    uint8 Second = 0;
+};
+
+// Immutable snapshot of all ServerAutoShutdown.* options, parsed once in
+// Init() and published with an atomic swap. Scheduled tasks capture or load
+// the snapshot and never touch sConfigMgr at fire time, which also makes
+// config reload safe against tasks reading half-updated options
+struct ServerAutoShutdownConfig
+{
+    bool Enabled = false;
+    bool UseTimerThread = false;
+    uint32 EveryDays = 1;
+    uint8 Hour = 4;
+    uint8 Minute = 0;
+    uint8 Second = 0;
+    uint32 PreAnnounceSeconds = 3600;
+    std::string PreAnnounceMessage;
+    std::string StartEvents;
+
+    // Pre-shutdown flush pipeline: force-save online players in small batches
+    // across ticks during the announce window, so the final synchronous save
+    // at shutdown only has to write what changed since
+    bool PreFlushEnabled = false;
+    uint32 PreFlushBatchSize = 10;
+    uint32 PreFlushIntervalMs = 1000;
+
+    // Session drain: after the pre-announce fired, disconnect idle sessions
+    // (character select, AFK out of combat) in small batches across ticks, so
+    // the final synchronous teardown at shutdown handles only a fraction of
+    // the session count
+    bool DrainEnabled = false;
+    uint32 DrainBatchSize = 5;
+    uint32 DrainIntervalMs = 5000;
+
+    // Unload the grids of playerless maps in small batches during the
+    // announce window, so the final teardown at exit only walks maps that
+    // still host players
+    bool PreUnloadEnabled = false;
+    uint32 PreUnloadBatchSize = 2;
+    uint32 PreUnloadIntervalMs = 2000;
+
+    // SQL maintenance tasks run against the character DB during the announce
+    // window, sequentially through the async DB infrastructure; no new task
+    // starts once the deadline before the shutdown is reached
+    bool MaintenanceEnabled = false;
+    std::vector<std::string> MaintenanceTasks;
+    uint32 MaintenanceDeadlineSeconds = 120;
+
+    // Watch the module's own config file with inotify and re-arm through the
+    // async snapshot swap on edits - no whole-core .reload config needed
+    bool HotWatchEnabled = false;
+    std::string HotWatchFile;
+
+    // Lifecycle notifications posted as JSON to an ops webhook. Only plain
+    // http:// is spoken - terminate TLS in a local relay when the endpoint
+    // (e.g. Discord) requires https
+    bool WebhookEnabled = false;
+    std::string WebhookUrl;
+    std::string WebhookHost;
+    std::string WebhookPort;
+    std::string WebhookTarget;
+    uint32 WebhookTimeoutMs = 2000;
+
+    // Feed the countdown to a client addon over the addon channel: one
+    // compact prebuilt packet per rung instead of per-session string chat
+    bool AddonEnabled = false;
+    std::string AddonPrefix;
+
+    // Adaptive restart triggers, sampled on a coarse repeating timer: pull
+    // the restart forward once process uptime or RSS crosses a threshold,
+    // instead of waiting for the fixed time of day. A threshold of 0
+    // disables that particular trigger
+    bool AdaptiveEnabled = false;
+    uint32 AdaptiveMaxUptimeHours = 0;
+    uint32 AdaptiveMaxRssMB = 0;
+    uint32 AdaptiveSampleSeconds = 60;
+
+    // Measure OnUpdate durations and fire drift; off by default so the fast
+    // path stays two integer operations without clock reads
+    bool PerfEnabled = false;
+
+    // Restart veto backoff: while a registered veto counter is positive the
+    // shutdown is retried every VetoBackoffSeconds, for at most
+    // VetoMaxExtendSeconds past the first attempt
+    uint32 VetoBackoffSeconds = 60;
+    uint32 VetoMaxExtendSeconds = 1800;
+
+    // Multi-realm staggering: claim a restart slot in a shared auth DB table
+    // and delay this realm's shutdown by slot * StaggerStepSeconds, so realms
+    // on the same schedule do not save and restart simultaneously
+    bool StaggerEnabled = false;
+    uint32 StaggerStepSeconds = 300;
+    uint32 StaggerMaxSlots = 16;
+
+    // Low-population window: instead of firing blindly at the scheduled time,
+    // wait up to WindowMaxExtendSeconds for the cached session count to drop
+    // below WindowMaxSessions, then shut down after WindowFireDelaySeconds
+    bool WindowEnabled = false;
+    uint32 WindowMaxExtendSeconds = 7200;
+    uint32 WindowMaxSessions = 10;
+    uint32 WindowSampleSeconds = 30;
+    uint32 WindowFireDelaySeconds = 60;
+
+    // Multiple cron-like schedules, e.g. different times on weekdays and
+    // weekends. Empty = use the single Time/EveryDays schedule
+    std::vector<ShutdownScheduleEntry> Schedules;
+
+    // Optional per-locale message templates; index LOCALE_enUS holds the
+    // default PreAnnounce.Message, empty entries fall back to it
+    std::array<std::string, TOTAL_LOCALES> LocaleMessageFormats;
+    bool HasLocalizedMessages = false;
+
+    // One fully formatted announce per locale; empty entries fall back to the
+    // default locale at broadcast time
+    using AnnounceMessages = std::array<std::string, TOTAL_LOCALES>;
+
+    // Population-adaptive announce cadence: above this session count only
+    // coarse rungs (plus the first and final rung) broadcast, bounding the
+    // per-rung fan-out cost on full realms. 0 keeps full density
+    uint32 LadderFullDensitySessions = 0;
+    uint32 LadderCoarseSeconds = 300;
+
+    // Countdown ladder, sorted by seconds-before-shutdown descending. The
+    // messages for every rung and locale are fully formatted here at parse
+    // time, fire-time work is just handing a prebuilt string per session.
+    // SessionCap holds the precomputed thinning policy: the rung broadcasts
+    // only while the session count is at or below it
+    struct LadderRung
+    {
+        uint32 SecondsBefore = 0;
+        uint32 SessionCap = std::numeric_limits<uint32>::max();
+        AnnounceMessages Messages;
+    };
+
+    std::vector<LadderRung> LadderMessages;
+};
+
+// Snapshot of the module's performance counters, safe to take from any
+// thread (metrics exporters poll GetPerfStats). All zero until
+// ServerAutoShutdown.Perf.Enabled is set
+struct ServerAutoShutdownPerfStats
+{
+    uint64 UpdateCalls = 0;      // OnUpdate invocations measured
+    uint64 WheelWakeups = 0;     // ticks where the gate opened
+    uint64 UpdateMinNs = 0;      // fastest measured OnUpdate
+    uint64 UpdateAvgNs = 0;
+    uint64 UpdateP99Ns = 0;      // from the log2 histogram, upper bucket bound
+    uint64 LastFireDriftMs = 0;  // most recent fire past its deadline
+    uint64 MaxFireDriftMs = 0;
+    uint64 LastInitNs = 0;       // duration of the last ApplyScheduleData
+};
+
+// Restart lifecycle moments posted to the configured webhook. The world
+// thread only enqueues a small POD event; the HTTP I/O runs on a worker
+enum ShutdownWebhookEvent : uint8
+{
+    WEBHOOK_SCHEDULE_ARMED = 0,
+    WEBHOOK_PRE_ANNOUNCE,
+    WEBHOOK_SHUTDOWN_FIRED,
+    WEBHOOK_BACK_ONLINE
+};
+
+// One restart as recorded in the telemetry ring buffer file. Durations are
+// only known once the following startup finalized the record
+struct ServerAutoShutdownRestartRecord
+{
+    int64 ScheduledFireTime = 0;       // fire time the schedule asked for
+    int64 RequestedFireTime = 0;       // when ShutdownServ was actually issued
+    int64 ExitTime = 0;                // last write before process exit
+    uint32 CountdownSeconds = 0;       // countdown passed to ShutdownServ
+    uint32 SessionsAtPreAnnounce = 0;
+    uint32 SessionsAtFire = 0;
+    uint32 ShutdownDurationSeconds = 0; // countdown expiry to process exit
+    bool Complete = false;
+};
+
+// One installed shutdown veto condition. The owning script increments the
+// counter when a blocking situation begins (encounter pull, arena match
+// start, ...) and decrements it when it ends, so the shutdown decision point
+// only sums a handful of cached counters and never scans maps or instances
+struct ShutdownVetoCounter
+{
+    explicit ShutdownVetoCounter(std::string name) : Name(std::move(name)) { }
+
+    std::string const Name;
+    std::atomic<int32> Count = 0;
+};
+
+// Everything a (re)load has to compute: built off the world thread by
+// BuildScheduleData(), handed over through a mailbox and applied with
+// ApplyScheduleData(), so a .reload config costs the tick only the
+// arming work, not the parse
+struct ShutdownScheduleData
+{
+    std::shared_ptr<ServerAutoShutdownConfig const> Config;
+    std::vector<time_t> FireTimes;
+    uint64 ConfigHash = 0;
+    uint32 StaggerOffsetSeconds = 0;
+    bool WarmLoaded = false;
+
+    // Non-zero when the previous run crashed inside its announce window:
+    // the occurrence to resume (or complete, if it passed) instead of arming
+    // the next scheduled one
+    time_t ResumeShutdownTime = 0;
+};
 
 class ServerAutoShutdown
 {
@@ -29,8 +379,309 @@ public:
     void OnUpdate(uint32 diff);
     void StartPersistentGameEvents();
 
+    // Reload path: parse and compute on a detached thread, then publish the
+    // finished schedule through the mailbox drained by ProcessPendingInit()
+    void InitAsync();
+    void ProcessPendingInit();
+
+    // Install a veto condition; call once at script load, the returned
+    // counter stays valid for the lifetime of the process. While any
+    // registered counter is positive, restarts back off instead of firing
+    ShutdownVetoCounter* RegisterShutdownVeto(std::string name);
+
+    // Polling surface for the .sas perf command and external exporters
+    ServerAutoShutdownPerfStats GetPerfStats() const;
+
+    // Dry-run the whole Init()/OnUpdate() engine against a virtual clock,
+    // fast-forwarding the given number of days and logging every would-be
+    // shutdown and announce with its virtual timestamp. No World, DB or
+    // filesystem state is touched while the simulation is active
+    void RunScheduleSimulation(uint32 days);
+
+    // Timer thread mode: the deadline wait runs on a background thread and the
+    // world thread only drains a one-flag mailbox (World API is not thread safe)
+    bool IsTimerThreadEnabled() const { return _useTimerThread; }
+    void ProcessTimerThreadFire();
+
+    // Which WorldScript variant got registered; fixed for the process
+    // lifetime, a reload that flips UseTimerThread is clamped back to it
+    void SetRegisteredScriptMode(bool useTimerThread) { _scriptTimerThreadMode = useTimerThread; }
+
+    // Lock-free read of the current config snapshot
+    std::shared_ptr<ServerAutoShutdownConfig const> GetConfig() const { return std::atomic_load_explicit(&_config, std::memory_order_acquire); }
+
+    // Persist the computed schedule state (snapshot + fire table) so the next
+    // startup can re-arm from the file instead of re-deriving everything
+    void SaveStateFile() const;
+
+    // Restart telemetry ring buffer: stamp the process exit time into the
+    // last record (OnShutdown), finalize its measured shutdown duration on
+    // the next startup, and read the whole history for the .sas command
+    void RecordTelemetryExit() const;
+    void FinalizeRestartTelemetry() const;
+    std::vector<ServerAutoShutdownRestartRecord> GetRestartTelemetry() const;
+
+    // Enqueue one lifecycle event for the webhook worker; a full queue drops
+    // the event rather than ever blocking the world thread
+    void NotifyLifecycleEvent(ShutdownWebhookEvent type);
+
+    // Next armed shutdown from the fire table expanded at Init(), 0 if none
+    time_t GetNextShutdownTime() const { return _fireTimes.empty() ? 0 : _fireTimes.front(); }
+
+    // Operator surface for the armed occurrence only: move, delay or cancel
+    // the next shutdown without re-running Init() - no config parse, no
+    // mktime expansion and no game event restart. World thread only
+    bool Reschedule(time_t shutdownTime);
+    bool RescheduleTimeOfDay(uint8 hour, uint8 minute, uint8 second);
+    bool Postpone(Seconds delay);
+    bool CancelNext();
+
+    // O(log n) lookup against the validated event cache built at Init()
+    bool IsManagedEvent(uint32 eventId) const;
+
+    // Last sampled online session count, updated on a coarse timer while the
+    // low-population window is open. Safe to read from any thread
+    uint32 GetCachedSessionCount() const { return _cachedSessionCount.load(std::memory_order_relaxed); }
+
 private:
+    ~ServerAutoShutdown();
+
+    // Parse and validate all module options into a fresh snapshot, nullptr on error
+    std::shared_ptr<ServerAutoShutdownConfig const> LoadConfig() const;
+
+    // The compute half of Init(): safe off the world thread, touches only
+    // sConfigMgr, the state file and the auth DB
+    ShutdownScheduleData BuildScheduleData() const;
+
+    // The arming half of Init(): world thread only
+    void ApplyScheduleData(ShutdownScheduleData data);
+
+    // Hash over the raw option strings, used to invalidate the state file
+    uint64 ComputeConfigHash() const;
+
+    // Rebuild snapshot and fire table from the state file; false when the file
+    // is missing, stale (hash mismatch) or holds no future occurrence
+    bool TryLoadStateFile(uint64 configHash, std::shared_ptr<ServerAutoShutdownConfig const>& config, std::vector<time_t>& fireTimes, time_t& resumeShutdownTime) const;
+
+    // Re-arm the update gate: the timer wheel update is skipped until the
+    // next slot deadline is closer than the wakeup window
+    void ArmSchedulerGate(uint32 msToNextTask);
+
+    void DoPreAnnounce(std::shared_ptr<ServerAutoShutdownConfig const> const& config);
+    void ArmLadderRung(std::size_t rungIndex);
+
+    // Send one prebuilt string per session, grouped by session locale; falls
+    // back to one global broadcast when no localized templates are configured
+    void BroadcastAnnounce(std::shared_ptr<ServerAutoShutdownConfig const> const& config, ServerAutoShutdownConfig::AnnounceMessages const& messages);
+
+    // Addon countdown path: build every rung packet once at arm time, then
+    // enqueue the matching shared buffer at fire time
+    void BuildAddonPackets(std::shared_ptr<ServerAutoShutdownConfig const> const& config);
+    void BroadcastAddonCountdown(uint32 secondsRemaining);
+    void ArmShutdownWindow();
+
+    // Timer-only half of ApplyScheduleData: stand down the armed occurrence
+    // and re-arm announce/window/timer thread at the new shutdown time
+    bool RearmOccurrence(time_t shutdownTime);
+
+    void StartPreFlushPipeline();
+    void StartDrainPipeline();
+    void StartMaintenancePipeline();
+    void StartPreUnloadPipeline();
+    void BuildPersistentEventCache(std::shared_ptr<ServerAutoShutdownConfig const> const& config);
+
+    // Timer wheel callbacks: plain function pointers, the module is the context
+    static void FirePreAnnounce(ServerAutoShutdown& self);
+    static void FireLadderRung(ServerAutoShutdown& self);
+    static void FireWindowGate(ServerAutoShutdown& self);
+    static void FirePreFlushBatch(ServerAutoShutdown& self);
+    static void FireDrainBatch(ServerAutoShutdown& self);
+    static void FireClockResync(ServerAutoShutdown& self);
+    static void FireEventStart(ServerAutoShutdown& self);
+    static void FireVetoRetry(ServerAutoShutdown& self);
+    static void FireAdaptiveCheck(ServerAutoShutdown& self);
+    static void FireMaintenanceStep(ServerAutoShutdown& self);
+    static void FirePreUnloadBatch(ServerAutoShutdown& self);
+
+    // Single funnel for issuing the actual shutdown; applies veto backoff
+    // and the simulation sink in one place
+    void RequestShutdown(uint32 delaySeconds);
+
+    // Append one record for the restart being issued right now
+    void RecordRestartTelemetry(uint32 delaySeconds) const;
+
+    // First counter with a positive count, nullptr when nothing vetoes
+    ShutdownVetoCounter const* ActiveVeto();
+
+    // The former OnUpdate body; OnUpdate itself only adds the optional
+    // duration measurement around it
+    void UpdateCore(uint32 diff);
+    void RecordUpdateDuration(uint64 ns);
+
+    // Wall clock estimate derived from the last resync anchor plus monotonic
+    // elapsed time: no time() read and no timezone work on the fire paths
+    time_t WallNow() const;
+
+    // All epoch reads go through here so the simulation can substitute its
+    // virtual clock for time(nullptr)
+    time_t EpochNow() const { return _simActive ? _simNow : time(nullptr); }
+
+    // Simulation sinks for the calls that would mutate World state
+    void SimRecord(std::string what);
+    void SimShutdown(uint32 delaySeconds);
+
+    void ArmTimerThread(time_t fireTime);
+    void StopTimerThread();
+    void TimerThreadMain();
+
+    void StartWebhookThread();
+    void StopWebhookThread();
+    void WebhookThreadMain();
+
+    // The shared body of InitAsync() and the hot-watch thread: build the
+    // schedule off-thread and publish it into the reload mailbox
+    void BuildAndPublishScheduleData();
+
+    void StartConfigWatchThread(std::string path);
+    void StopConfigWatchThread();
+    void ConfigWatchThreadMain();
+
     bool _isEnableModule = false;
+    uint32 _msToNextTask = 0;
+    uint32 _msSinceLastUpdate = 0;
+
+    ShutdownTimerWheel _timers;
+
+    // World-thread-only state the wheel callbacks operate on; replaced as a
+    // whole on every Init() together with the wheel slots
+    std::shared_ptr<ServerAutoShutdownConfig const> _armedConfig;
+    time_t _armedShutdownTime = 0;
+    uint32 _armedPreAnnounceSeconds = 0;
+    ServerAutoShutdownConfig::AnnounceMessages _armedPreAnnounceMessages;
+    std::size_t _ladderIndex = 0;
+    time_t _windowEnd = 0;
+    // One immutable prebuilt addon packet per countdown rung, keyed by the
+    // remaining seconds it encodes; broadcast enqueues the same buffer to
+    // every session, no per-session formatting or copies
+    std::vector<std::pair<uint32, WorldPacket>> _addonPackets;
+
+    std::vector<ObjectGuid> _preFlushGuids;
+    std::size_t _preFlushCursor = 0;
+    std::vector<uint32> _drainAccountIds;
+    std::size_t _drainCursor = 0;
+
+    // Pre-unload snapshot as (mapId, instanceId) pairs - map pointers are
+    // re-resolved at batch time since maps can be destroyed between ticks
+    std::vector<std::pair<uint32, uint32>> _preUnloadMaps;
+    std::size_t _preUnloadCursor = 0;
+
+    // Maintenance pipeline: one async character DB task in flight at a time,
+    // completions drained by the repeating wheel slot. The generation guards
+    // a late completion against state reset by a reload mid-task
+    QueryCallbackProcessor _maintenanceQueries;
+    std::size_t _maintenanceCursor = 0;
+    time_t _maintenanceDeadline = 0;
+    std::chrono::steady_clock::time_point _maintenanceTaskStart;
+    uint32 _maintenanceGeneration = 0;
+    bool _maintenanceActive = false;
+    bool _maintenanceTaskRunning = false;
+
+    bool _useTimerThread = false;
+    bool _scriptTimerThreadMode = false;
+    std::thread _timerThread;
+    std::mutex _timerMutex;
+    std::condition_variable _timerCondVar;
+    bool _timerThreadStop = false;       // guarded by _timerMutex
+    time_t _timerDeadline = 0;           // guarded by _timerMutex
+    uint32 _timerGeneration = 0;         // guarded by _timerMutex
+    std::atomic<bool> _pendingTimerFire = false;
+
+    // Webhook worker: bounded single-producer (world thread) single-consumer
+    // ring of POD events. Enqueue is two relaxed-ish atomic ops and a copy;
+    // the condvar only wakes the worker, it is never held while posting
+    struct WebhookEventData
+    {
+        uint8 Type = 0;
+        int64 When = 0;
+        int64 ShutdownTime = 0;
+        uint32 Sessions = 0;
+    };
+
+    static constexpr std::size_t WEBHOOK_QUEUE_SIZE = 64;
+    std::array<WebhookEventData, WEBHOOK_QUEUE_SIZE> _webhookQueue;
+    std::atomic<uint32> _webhookHead = 0; // consumer side
+    std::atomic<uint32> _webhookTail = 0; // producer side
+    std::thread _webhookThread;
+    std::mutex _webhookMutex;
+    std::condition_variable _webhookCondVar;
+    std::atomic<bool> _webhookStop = false;
+
+    // Config hot-watch worker (Linux inotify). The watcher never touches the
+    // shared option cache itself: it raises this flag and ProcessPendingInit
+    // reloads on the world thread, where GetOption readers can't race it
+    std::thread _configWatchThread;
+    std::atomic<bool> _configWatchStop = false;
+    std::atomic<bool> _pendingConfigReload = false;
+    std::string _configWatchPath; // set before the thread starts, const after
+
+    // Async reload mailbox, last writer wins
+    std::shared_ptr<ShutdownScheduleData> _pendingInit; // atomic access only
+    std::atomic<bool> _hasPendingInit = false;
+
+    std::shared_ptr<ServerAutoShutdownConfig const> _config;
+
+    // Upcoming shutdown occurrences as sorted epoch seconds, expanded once in
+    // Init() so runtime lookups never go back through tm breakdown or mktime
+    std::vector<time_t> _fireTimes;
+
+    std::atomic<uint32> _cachedSessionCount = 0;
+    uint32 _telemetrySessionsAtPreAnnounce = 0;
+
+    // True from the first announce until the ShutdownServ call goes out;
+    // persisted in the state file so a crash inside the announce window is
+    // resumed on the next boot instead of rescheduled
+    bool _midCountdown = false;
+    bool _preFlushActive = false;
+    bool _drainActive = false;
+    bool _preUnloadActive = false;
+
+    // Perf counters, relaxed atomics: written from the world thread only,
+    // read by anyone. The log2 histogram buckets OnUpdate durations in ns
+    static constexpr std::size_t PERF_HISTOGRAM_BUCKETS = 32;
+    bool _perfEnabled = false;
+    std::atomic<uint64> _perfUpdateCalls = 0;
+    std::atomic<uint64> _perfWheelWakeups = 0;
+    std::atomic<uint64> _perfUpdateMinNs = UINT64_MAX;
+    std::atomic<uint64> _perfUpdateTotalNs = 0;
+    std::array<std::atomic<uint64>, PERF_HISTOGRAM_BUCKETS> _perfHistogram = {};
+    std::atomic<uint64> _perfLastDriftMs = 0;
+    std::atomic<uint64> _perfMaxDriftMs = 0;
+    std::atomic<uint64> _perfLastInitNs = 0;
+
+    // Veto registry; registration is rare and guarded, the counters
+    // themselves are updated lock-free by their owners
+    std::vector<std::unique_ptr<ShutdownVetoCounter>> _vetoCounters;
+    std::mutex _vetoMutex;
+    uint32 _pendingShutdownDelay = 0;
+    time_t _vetoGiveUpTime = 0;
+
+    // Virtual clock state, only meaningful while RunScheduleSimulation runs
+    bool _simActive = false;
+    time_t _simNow = 0;
+    time_t _simRestartAt = 0;
+    std::vector<std::pair<time_t, std::string>> _simEvents;
+
+    // Clock anchors taken together at Init() and at every resync; drift
+    // between the pair exposes wall clock steps
+    std::chrono::steady_clock::time_point _lastResyncSteady;
+    time_t _lastResyncWall = 0;
+    uint64 _configHash = 0;
+
+    // Validated, sorted, deduplicated event IDs from StartEvents, parsed once
+    // at Init() instead of re-tokenizing the option on every invocation.
+    // Started one per wheel fire after startup, cursor tracks progress
+    std::vector<uint32> _persistentEvents;
+    std::size_t _eventStartCursor = 0;
 };
 
 #define sSAS ServerAutoShutdown::instance()
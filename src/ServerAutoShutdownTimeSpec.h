@@ -0,0 +1,78 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SERVER_AUTO_SHUTDOWN_TIME_SPEC_H_
+#define _SERVER_AUTO_SHUTDOWN_TIME_SPEC_H_
+
+#include "Define.h"
+#include "Optional.h"
+
+#include <string_view>
+
+// Parsed HH:MM:SS time of day
+struct TimeSpec
+{
+    uint8 Hour = 0;
+    uint8 Minute = 0;
+    uint8 Second = 0;
+};
+
+// Single-pass HH:MM:SS parser: walks the string once, no tokenization, no
+// heap allocation, every value parsed and range-checked exactly once.
+// constexpr so default specs are validated at compile time
+constexpr Optional<TimeSpec> ParseTimeSpec(std::string_view spec)
+{
+    uint32 values[3] = {};
+    std::size_t field = 0;
+    std::size_t digits = 0;
+
+    for (char c : spec)
+    {
+        if (c == ':')
+        {
+            if (!digits || field >= 2)
+                return std::nullopt;
+
+            ++field;
+            digits = 0;
+            continue;
+        }
+
+        if (c < '0' || c > '9' || digits >= 2)
+            return std::nullopt;
+
+        values[field] = values[field] * 10 + static_cast<uint32>(c - '0');
+        ++digits;
+    }
+
+    if (field != 2 || !digits)
+        return std::nullopt;
+
+    if (values[0] > 23 || values[1] > 59 || values[2] > 59)
+        return std::nullopt;
+
+    return TimeSpec{ static_cast<uint8>(values[0]), static_cast<uint8>(values[1]), static_cast<uint8>(values[2]) };
+}
+
+static_assert(ParseTimeSpec("04:00:00"), "default ServerAutoShutdown.Time must parse");
+static_assert(ParseTimeSpec("23:59:59"), "upper bound must parse");
+static_assert(!ParseTimeSpec("24:00:00"), "hour out of range must be rejected");
+static_assert(!ParseTimeSpec("04:60:00"), "minute out of range must be rejected");
+static_assert(!ParseTimeSpec("04:00"), "missing field must be rejected");
+static_assert(!ParseTimeSpec("04:00:0x"), "non-digit must be rejected");
+
+#endif /* _SERVER_AUTO_SHUTDOWN_TIME_SPEC_H_ */
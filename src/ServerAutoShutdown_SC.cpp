@@ -16,10 +16,14 @@
  */
 
 #include "ServerAutoShutdown.h"
+#include "ServerAutoShutdownTimeSpec.h"
+#include "Chat.h"
 #include "Config.h"
 #include "Log.h"
 #include "ScriptMgr.h"
-#include "TaskScheduler.h"
+#include "Util.h"
+
+using namespace Acore::ChatCommands;
 
 class ServerAutoShutdown_World : public WorldScript
 {
@@ -31,20 +35,208 @@ public:
         sSAS->OnUpdate(diff);
     }
 
+    void OnAfterConfigLoad(bool reload) override
+    {
+        // Parse and compute off-thread; the tick only pays the apply
+        if (reload)
+            sSAS->InitAsync();
+    }
+
+    void OnStartup() override
+    {
+        // Optional dry run first: fast-forward the configured schedule on a
+        // virtual clock and log every would-be shutdown and announce
+        if (uint32 days = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Simulate.Days", 0))
+            sSAS->RunScheduleSimulation(days);
+
+        // Turn the exit stamp of the previous run into a measured duration
+        sSAS->FinalizeRestartTelemetry();
+
+        sSAS->Init();
+        sSAS->NotifyLifecycleEvent(WEBHOOK_BACK_ONLINE);
+    }
+
+    void OnShutdown() override
+    {
+        sSAS->SaveStateFile();
+        sSAS->RecordTelemetryExit();
+    }
+};
+
+// Timer thread mode: no scheduler to tick, OnUpdate only drains the fire mailbox
+class ServerAutoShutdown_TimerThreadWorld : public WorldScript
+{
+public:
+    ServerAutoShutdown_TimerThreadWorld() : WorldScript("ServerAutoShutdown_TimerThreadWorld") { }
+
+    void OnUpdate(uint32 /*diff*/) override
+    {
+        sSAS->ProcessPendingInit();
+        sSAS->ProcessTimerThreadFire();
+    }
+
     void OnAfterConfigLoad(bool reload) override
     {
         if (reload)
-            sSAS->Init();
+            sSAS->InitAsync();
     }
 
     void OnStartup() override
     {
+        // The dry run always drives the wheel engine, regardless of mode
+        if (uint32 days = sConfigMgr->GetOption<uint32>("ServerAutoShutdown.Simulate.Days", 0))
+            sSAS->RunScheduleSimulation(days);
+
+        sSAS->FinalizeRestartTelemetry();
+
         sSAS->Init();
+        sSAS->NotifyLifecycleEvent(WEBHOOK_BACK_ONLINE);
+    }
+
+    void OnShutdown() override
+    {
+        sSAS->SaveStateFile();
+        sSAS->RecordTelemetryExit();
+    }
+};
+
+class ServerAutoShutdown_CommandScript : public CommandScript
+{
+public:
+    ServerAutoShutdown_CommandScript() : CommandScript("ServerAutoShutdown_CommandScript") { }
+
+    ChatCommandTable GetCommands() const override
+    {
+        static ChatCommandTable sasCommandTable =
+        {
+            { "cancelnext", HandleCancelNextCommand, SEC_ADMINISTRATOR, Console::Yes },
+            { "perf",       HandlePerfCommand,       SEC_ADMINISTRATOR, Console::Yes },
+            { "postpone",   HandlePostponeCommand,   SEC_ADMINISTRATOR, Console::Yes },
+            { "reschedule", HandleRescheduleCommand, SEC_ADMINISTRATOR, Console::Yes },
+            { "telemetry",  HandleTelemetryCommand,  SEC_ADMINISTRATOR, Console::Yes }
+        };
+
+        static ChatCommandTable commandTable =
+        {
+            { "sas", sasCommandTable }
+        };
+
+        return commandTable;
+    }
+
+    // .sas reschedule HH:MM:SS - move the armed shutdown to the next
+    // occurrence of that time of day, without the full reload cost
+    static bool HandleRescheduleCommand(ChatHandler* handler, std::string const& timeOfDay)
+    {
+        auto timeSpec = ParseTimeSpec(timeOfDay);
+        if (!timeSpec)
+        {
+            handler->PSendSysMessage("ServerAutoShutdown: incorrect time '{}', expected HH:MM:SS", timeOfDay);
+            return true;
+        }
+
+        if (!sSAS->RescheduleTimeOfDay(timeSpec->Hour, timeSpec->Minute, timeSpec->Second))
+        {
+            handler->PSendSysMessage("ServerAutoShutdown: can't reschedule (module disabled or target too close)");
+            return true;
+        }
+
+        handler->PSendSysMessage("ServerAutoShutdown: next shutdown rescheduled to {}", Acore::Time::TimeToHumanReadable(Seconds(sSAS->GetNextShutdownTime())));
+        return true;
+    }
+
+    // .sas postpone <seconds> - push the armed shutdown back
+    static bool HandlePostponeCommand(ChatHandler* handler, uint32 seconds)
+    {
+        if (!seconds || !sSAS->Postpone(Seconds(seconds)))
+        {
+            handler->PSendSysMessage("ServerAutoShutdown: can't postpone (module disabled or no shutdown armed)");
+            return true;
+        }
+
+        handler->PSendSysMessage("ServerAutoShutdown: next shutdown postponed by {} to {}",
+            Acore::Time::ToTimeString<Seconds>(seconds), Acore::Time::TimeToHumanReadable(Seconds(sSAS->GetNextShutdownTime())));
+        return true;
+    }
+
+    // .sas cancelnext - skip the armed occurrence entirely
+    static bool HandleCancelNextCommand(ChatHandler* handler)
+    {
+        if (!sSAS->CancelNext())
+        {
+            handler->PSendSysMessage("ServerAutoShutdown: nothing to cancel (module disabled or no shutdown armed)");
+            return true;
+        }
+
+        if (time_t next = sSAS->GetNextShutdownTime())
+            handler->PSendSysMessage("ServerAutoShutdown: next shutdown cancelled, following occurrence at {}", Acore::Time::TimeToHumanReadable(Seconds(next)));
+        else
+            handler->PSendSysMessage("ServerAutoShutdown: next shutdown cancelled, no further occurrence armed");
+
+        return true;
+    }
+
+    // .sas telemetry - recorded restart history from the ring buffer file,
+    // for sizing the announce/drain windows against measured shutdown cost
+    static bool HandleTelemetryCommand(ChatHandler* handler)
+    {
+        std::vector<ServerAutoShutdownRestartRecord> records = sSAS->GetRestartTelemetry();
+
+        if (records.empty())
+        {
+            handler->PSendSysMessage("ServerAutoShutdown: no recorded restarts yet (is ServerAutoShutdown.Telemetry.Enabled set?)");
+            return true;
+        }
+
+        handler->PSendSysMessage("ServerAutoShutdown: {} recorded restart(s), newest last:", records.size());
+
+        for (auto const& record : records)
+        {
+            int64 lateSeconds = record.RequestedFireTime - record.ScheduledFireTime;
+
+            if (record.Complete)
+                handler->PSendSysMessage("ServerAutoShutdown: {} | fired {:+} s off schedule | {} -> {} sessions | teardown {} s",
+                    Acore::Time::TimeToHumanReadable(Seconds(record.RequestedFireTime)), lateSeconds,
+                    record.SessionsAtPreAnnounce, record.SessionsAtFire, record.ShutdownDurationSeconds);
+            else
+                handler->PSendSysMessage("ServerAutoShutdown: {} | fired {:+} s off schedule | {} -> {} sessions | teardown not measured",
+                    Acore::Time::TimeToHumanReadable(Seconds(record.RequestedFireTime)), lateSeconds,
+                    record.SessionsAtPreAnnounce, record.SessionsAtFire);
+        }
+
+        return true;
+    }
+
+    static bool HandlePerfCommand(ChatHandler* handler)
+    {
+        ServerAutoShutdownPerfStats stats = sSAS->GetPerfStats();
+
+        if (!stats.UpdateCalls)
+        {
+            handler->PSendSysMessage("ServerAutoShutdown: no samples yet (is ServerAutoShutdown.Perf.Enabled set?)");
+            return true;
+        }
+
+        handler->PSendSysMessage("ServerAutoShutdown: {} OnUpdate calls, {} wheel wakeups", stats.UpdateCalls, stats.WheelWakeups);
+        handler->PSendSysMessage("ServerAutoShutdown: OnUpdate min {} ns, avg {} ns, p99 < {} ns", stats.UpdateMinNs, stats.UpdateAvgNs, stats.UpdateP99Ns);
+        handler->PSendSysMessage("ServerAutoShutdown: fire drift last {} ms, max {} ms; last init {} us", stats.LastFireDriftMs, stats.MaxFireDriftMs, stats.LastInitNs / 1000);
+        return true;
     }
 };
 
 // Group all custom scripts
 void AddSC_ServerAutoShutdown()
 {
-    new ServerAutoShutdown_World();
+    bool useTimerThread = sConfigMgr->GetOption<bool>("ServerAutoShutdown.UseTimerThread", false);
+
+    // The registered variant is fixed for the process lifetime; reloads that
+    // flip UseTimerThread are clamped to it in ApplyScheduleData
+    sSAS->SetRegisteredScriptMode(useTimerThread);
+
+    if (useTimerThread)
+        new ServerAutoShutdown_TimerThreadWorld();
+    else
+        new ServerAutoShutdown_World();
+
+    new ServerAutoShutdown_CommandScript();
 }